@@ -0,0 +1,428 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace abouttt
+{
+
+// One std::array of lanes per field, nested member by member. Unlike std::tuple, the nesting
+// is an aggregate, so a block is trivially copyable whenever its fields are.
+template <size_t Lanes, typename... Fields>
+struct AoSoALanes
+{
+};
+
+template <size_t Lanes, typename First, typename... Rest>
+struct AoSoALanes<Lanes, First, Rest...>
+{
+	std::array<First, Lanes> Values;
+	[[no_unique_address]] AoSoALanes<Lanes, Rest...> Next;
+};
+
+template <size_t Lanes, typename... Fields>
+class AoSoABlock
+{
+public:
+	template <size_t I>
+	using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+public:
+	template <size_t I>
+	std::array<FieldType<I>, Lanes>& Field() noexcept
+	{
+		return lanes<I>(mFields);
+	}
+
+	template <size_t I>
+	const std::array<FieldType<I>, Lanes>& Field() const noexcept
+	{
+		return lanes<I>(mFields);
+	}
+
+private:
+	template <size_t I, typename Nested>
+	static auto& lanes(Nested& nested) noexcept
+	{
+		if constexpr (I == 0)
+		{
+			return nested.Values;
+		}
+		else
+		{
+			return lanes<I - 1>(nested.Next);
+		}
+	}
+
+private:
+	alignas(64) AoSoALanes<Lanes, Fields...> mFields;
+};
+
+template <size_t Lanes, typename... Fields>
+class AoSoAArray
+{
+	static_assert(sizeof...(Fields) > 0, "AoSoAArray requires at least one field");
+	static_assert(Lanes > 0 && (Lanes & (Lanes - 1)) == 0, "AoSoAArray lane count must be a power of two");
+	static_assert((std::is_trivially_copyable_v<Fields> && ...), "AoSoAArray fields must be trivially copyable");
+
+public:
+	using Block = AoSoABlock<Lanes, Fields...>;
+
+	static_assert(std::is_trivially_copyable_v<Block>, "AoSoAArray copies blocks as raw bytes");
+
+	template <size_t I>
+	using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+	using Reference = std::tuple<Fields&...>;
+	using ConstReference = std::tuple<const Fields&...>;
+
+public:
+	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
+	static constexpr size_t LANES = Lanes;
+
+public:
+	AoSoAArray() noexcept
+		: AoSoAArray(0)
+	{
+	}
+
+	explicit AoSoAArray(size_t capacity)
+		: mBlocks(nullptr)
+		, mCount(0)
+		, mBlockCapacity(0)
+	{
+		reallocate(blocksFor(capacity));
+	}
+
+	AoSoAArray(const AoSoAArray& other)
+		: AoSoAArray(other.mCount)
+	{
+		std::memcpy(mBlocks, other.mBlocks, sizeof(Block) * blocksFor(other.mCount));
+		mCount = other.mCount;
+	}
+
+	AoSoAArray(AoSoAArray&& other) noexcept
+		: mBlocks(std::exchange(other.mBlocks, nullptr))
+		, mCount(std::exchange(other.mCount, 0))
+		, mBlockCapacity(std::exchange(other.mBlockCapacity, 0))
+	{
+	}
+
+	~AoSoAArray()
+	{
+		cleanup();
+	}
+
+public:
+	AoSoAArray& operator=(const AoSoAArray& other)
+	{
+		if (this != &other)
+		{
+			AoSoAArray temp(other);
+			Swap(temp);
+		}
+		return *this;
+	}
+
+	AoSoAArray& operator=(AoSoAArray&& other) noexcept
+	{
+		if (this != &other)
+		{
+			cleanup();
+			mBlocks = std::exchange(other.mBlocks, nullptr);
+			mCount = std::exchange(other.mCount, 0);
+			mBlockCapacity = std::exchange(other.mBlockCapacity, 0);
+		}
+		return *this;
+	}
+
+	Reference operator[](size_t index)
+	{
+		checkRange(index);
+		return row(index, std::index_sequence_for<Fields...>{});
+	}
+
+	ConstReference operator[](size_t index) const
+	{
+		checkRange(index);
+		return row(index, std::index_sequence_for<Fields...>{});
+	}
+
+public:
+	void Add(const Fields&... values)
+	{
+		ensureCapacity(mCount + 1);
+		assignRow(mCount, std::index_sequence_for<Fields...>{}, values...);
+		++mCount;
+	}
+
+	Block& GetBlock(size_t blockIndex)
+	{
+		checkBlockRange(blockIndex);
+		return mBlocks[blockIndex];
+	}
+
+	const Block& GetBlock(size_t blockIndex) const
+	{
+		checkBlockRange(blockIndex);
+		return mBlocks[blockIndex];
+	}
+
+	size_t BlockCount() const noexcept
+	{
+		return blocksFor(mCount);
+	}
+
+	// Trailing lanes of the last block are value-initialized, so kernels may process every
+	// block at full width and simply ignore results past Count().
+	std::span<Block> Blocks() noexcept
+	{
+		return std::span<Block>(mBlocks, BlockCount());
+	}
+
+	std::span<const Block> Blocks() const noexcept
+	{
+		return std::span<const Block>(mBlocks, BlockCount());
+	}
+
+	size_t Capacity() const noexcept
+	{
+		return mBlockCapacity * Lanes;
+	}
+
+	void Clear() noexcept
+	{
+		std::uninitialized_value_construct_n(mBlocks, BlockCount());
+		mCount = 0;
+	}
+
+	size_t Count() const noexcept
+	{
+		return mCount;
+	}
+
+	template <typename Predicate>
+	size_t FindIf(Predicate pred) const
+	{
+		for (size_t i = 0; i < mCount; ++i)
+		{
+			if (pred((*this)[i]))
+			{
+				return i;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	template <typename Function>
+	void ForEachBlock(Function func)
+	{
+		for (size_t b = 0, blockCount = BlockCount(); b < blockCount; ++b)
+		{
+			func(mBlocks[b], LaneCount(b));
+		}
+	}
+
+	template <typename Function>
+	void ForEachBlock(Function func) const
+	{
+		for (size_t b = 0, blockCount = BlockCount(); b < blockCount; ++b)
+		{
+			func(mBlocks[b], LaneCount(b));
+		}
+	}
+
+	template <size_t I>
+	FieldType<I>& Get(size_t index)
+	{
+		checkRange(index);
+		return mBlocks[index / Lanes].template Field<I>()[index % Lanes];
+	}
+
+	template <size_t I>
+	const FieldType<I>& Get(size_t index) const
+	{
+		checkRange(index);
+		return mBlocks[index / Lanes].template Field<I>()[index % Lanes];
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return mCount == 0;
+	}
+
+	size_t LaneCount(size_t blockIndex) const noexcept
+	{
+		size_t first = blockIndex * Lanes;
+		return first >= mCount ? 0 : std::min(Lanes, mCount - first);
+	}
+
+	void RemoveAt(size_t index)
+	{
+		checkRange(index);
+		for (size_t i = index + 1; i < mCount; ++i)
+		{
+			copyRow(i, i - 1, std::index_sequence_for<Fields...>{});
+		}
+		--mCount;
+		clearRow(mCount, std::index_sequence_for<Fields...>{});
+	}
+
+	void RemoveAtSwap(size_t index)
+	{
+		checkRange(index);
+		if (index < mCount - 1)
+		{
+			copyRow(mCount - 1, index, std::index_sequence_for<Fields...>{});
+		}
+		--mCount;
+		clearRow(mCount, std::index_sequence_for<Fields...>{});
+	}
+
+	void Reserve(size_t newCapacity)
+	{
+		if (newCapacity > Capacity())
+		{
+			reallocate(blocksFor(newCapacity));
+		}
+	}
+
+	void Shrink()
+	{
+		if (mBlockCapacity > BlockCount())
+		{
+			reallocate(BlockCount());
+		}
+	}
+
+	void Swap(AoSoAArray& other) noexcept
+	{
+		std::swap(mBlocks, other.mBlocks);
+		std::swap(mCount, other.mCount);
+		std::swap(mBlockCapacity, other.mBlockCapacity);
+	}
+
+private:
+	static constexpr size_t blocksFor(size_t count) noexcept
+	{
+		return (count + Lanes - 1) / Lanes;
+	}
+
+	template <size_t... I>
+	Reference row(size_t index, std::index_sequence<I...>)
+	{
+		Block& block = mBlocks[index / Lanes];
+		return Reference(block.template Field<I>()[index % Lanes]...);
+	}
+
+	template <size_t... I>
+	ConstReference row(size_t index, std::index_sequence<I...>) const
+	{
+		const Block& block = mBlocks[index / Lanes];
+		return ConstReference(block.template Field<I>()[index % Lanes]...);
+	}
+
+	template <size_t... I>
+	void assignRow(size_t index, std::index_sequence<I...>, const Fields&... values)
+	{
+		Block& block = mBlocks[index / Lanes];
+		((block.template Field<I>()[index % Lanes] = values), ...);
+	}
+
+	template <size_t... I>
+	void copyRow(size_t from, size_t to, std::index_sequence<I...>)
+	{
+		const Block& source = mBlocks[from / Lanes];
+		Block& target = mBlocks[to / Lanes];
+		((target.template Field<I>()[to % Lanes] = source.template Field<I>()[from % Lanes]), ...);
+	}
+
+	template <size_t... I>
+	void clearRow(size_t index, std::index_sequence<I...>)
+	{
+		Block& block = mBlocks[index / Lanes];
+		((block.template Field<I>()[index % Lanes] = FieldType<I>()), ...);
+	}
+
+	void checkRange(size_t index) const
+	{
+		if (index >= mCount)
+		{
+			throw std::out_of_range("AoSoAArray index out of range");
+		}
+	}
+
+	void checkBlockRange(size_t blockIndex) const
+	{
+		if (blockIndex >= BlockCount())
+		{
+			throw std::out_of_range("AoSoAArray block index out of range");
+		}
+	}
+
+	void ensureCapacity(size_t minCapacity)
+	{
+		if (minCapacity > Capacity())
+		{
+			size_t grow = mBlockCapacity + (mBlockCapacity >> 1); // Grow by 1.5x
+			size_t newBlockCapacity = std::max(blocksFor(minCapacity), mBlockCapacity == 0 ? 1 : grow);
+			reallocate(newBlockCapacity);
+		}
+	}
+
+	void reallocate(size_t newBlockCapacity)
+	{
+		if (newBlockCapacity == mBlockCapacity)
+		{
+			return;
+		}
+
+		if (newBlockCapacity == 0)
+		{
+			cleanup();
+			return;
+		}
+
+		Block* newBlocks = static_cast<Block*>(::operator new(sizeof(Block) * newBlockCapacity, std::align_val_t(alignof(Block))));
+		std::uninitialized_value_construct_n(newBlocks, newBlockCapacity);
+		size_t newCount = std::min(mCount, newBlockCapacity * Lanes);
+
+		if (mBlocks)
+		{
+			std::memcpy(newBlocks, mBlocks, sizeof(Block) * blocksFor(newCount));
+			cleanup();
+		}
+
+		mBlocks = newBlocks;
+		mCount = newCount;
+		mBlockCapacity = newBlockCapacity;
+	}
+
+	void cleanup() noexcept
+	{
+		if (mBlocks)
+		{
+			::operator delete(mBlocks, std::align_val_t(alignof(Block)));
+			mBlocks = nullptr;
+			mCount = 0;
+			mBlockCapacity = 0;
+		}
+	}
+
+private:
+	Block* mBlocks;
+	size_t mCount;
+	size_t mBlockCapacity;
+};
+
+} // namespace abouttt
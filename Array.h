@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <compare>
 #include <initializer_list>
 #include <iterator>
@@ -30,46 +31,46 @@ public:
 	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
 
 public:
-	Array() noexcept
+	constexpr Array() noexcept
 		: Array(0)
 	{
 	}
 
-	explicit Array(size_t capacity)
-		: mData(capacity > 0 ? static_cast<T*>(::operator new(sizeof(T) * capacity)) : nullptr)
+	constexpr explicit Array(size_t capacity)
+		: mData(capacity > 0 ? std::allocator<T>().allocate(capacity) : nullptr)
 		, mCount(0)
 		, mCapacity(capacity)
 	{
 	}
 
-	Array(std::initializer_list<T> ilist)
+	constexpr Array(std::initializer_list<T> ilist)
 		: Array(ilist.size())
 	{
-		std::uninitialized_copy(ilist.begin(), ilist.end(), mData);
+		uninitializedCopy(ilist.begin(), ilist.size(), mData);
 		mCount = ilist.size();
 	}
 
-	Array(const Array& other)
+	constexpr Array(const Array& other)
 		: Array(other.mCount)
 	{
-		std::uninitialized_copy(other.mData, other.mData + other.mCount, mData);
+		uninitializedCopy(other.mData, other.mCount, mData);
 		mCount = other.mCount;
 	}
 
-	Array(Array&& other) noexcept
+	constexpr Array(Array&& other) noexcept
 		: mData(std::exchange(other.mData, nullptr))
 		, mCount(std::exchange(other.mCount, 0))
 		, mCapacity(std::exchange(other.mCapacity, 0))
 	{
 	}
 
-	~Array()
+	constexpr ~Array()
 	{
 		cleanup();
 	}
 
 public:
-	Array& operator=(const Array& other)
+	constexpr Array& operator=(const Array& other)
 	{
 		if (this != &other)
 		{
@@ -79,7 +80,7 @@ public:
 		return *this;
 	}
 
-	Array& operator=(Array&& other) noexcept
+	constexpr Array& operator=(Array&& other) noexcept
 	{
 		if (this != &other)
 		{
@@ -91,26 +92,26 @@ public:
 		return *this;
 	}
 
-	Array& operator=(std::initializer_list<T> ilist)
+	constexpr Array& operator=(std::initializer_list<T> ilist)
 	{
 		Array temp(ilist);
 		Swap(temp);
 		return *this;
 	}
 
-	T& operator[](size_t index)
+	constexpr T& operator[](size_t index)
 	{
 		checkRange(index);
 		return mData[index];
 	}
 
-	const T& operator[](size_t index) const
+	constexpr const T& operator[](size_t index) const
 	{
 		checkRange(index);
 		return mData[index];
 	}
 
-	auto operator<=>(const Array& other) const
+	constexpr auto operator<=>(const Array& other) const
 	{
 		return std::lexicographical_compare_three_way(
 			mData, mData + mCount,
@@ -118,117 +119,134 @@ public:
 		);
 	}
 
-	bool operator==(const Array& other) const
+	constexpr bool operator==(const Array& other) const
 	{
 		return mCount == other.mCount && std::equal(mData, mData + mCount, other.mData);
 	}
 
 public:
-	void Add(const T& value)
+	constexpr void Add(const T& value)
 	{
 		Emplace(value);
 	}
 
-	void Add(T&& value)
+	constexpr void Add(T&& value)
 	{
 		Emplace(std::move(value));
 	}
 
-	void Append(const Array& source)
+	constexpr void Append(const Array& source)
 	{
 		Insert(mCount, source);
 	}
 
-	void Append(Array&& source)
+	constexpr void Append(Array&& source)
 	{
 		Insert(mCount, std::move(source));
 	}
 
-	void Append(std::initializer_list<T> ilist)
+	constexpr void Append(std::initializer_list<T> ilist)
 	{
 		Insert(mCount, ilist);
 	}
 
-	void Append(const T* ptr, size_t count)
+	constexpr void Append(const T* ptr, size_t count)
 	{
 		Insert(mCount, ptr, count);
 	}
 
-	size_t Capacity() const noexcept
+	constexpr size_t Capacity() const noexcept
 	{
 		return mCapacity;
 	}
 
-	void Clear() noexcept
+	constexpr void Clear() noexcept
 	{
 		std::destroy_n(mData, mCount);
 		mCount = 0;
 	}
 
-	bool Contains(const T& value) const
+	constexpr bool Contains(const T& value) const
 	{
 		return Find(value) != INDEX_NONE;
 	}
 
 	template <typename Predicate>
-	bool ContainsIf(Predicate pred) const
+	constexpr bool ContainsIf(Predicate pred) const
 	{
 		return FindIf(pred) != INDEX_NONE;
 	}
 
-	size_t Count() const noexcept
+	constexpr size_t Count() const noexcept
 	{
 		return mCount;
 	}
 
-	T* Data() noexcept
+	constexpr T* Data() noexcept
 	{
 		return mData;
 	}
 
-	const T* Data() const noexcept
+	constexpr const T* Data() const noexcept
 	{
 		return mData;
 	}
 
 	template <typename... Args>
-	T& Emplace(Args&&... args)
+	constexpr T& Emplace(Args&&... args)
 	{
 		size_t index = EmplaceAt(mCount, std::forward<Args>(args)...);
 		return mData[index];
 	}
 
+	// A throwing constructor leaves the array unchanged: unless the element can be built in
+	// place at the end, it is built first and moved into position once the tail has shifted.
 	template <typename... Args>
-	size_t EmplaceAt(size_t index, Args&&... args)
+	constexpr size_t EmplaceAt(size_t index, Args&&... args)
 	{
 		checkRange(index, true);
+
+		if (index == mCount && mCount < mCapacity)
+		{
+			std::construct_at(mData + mCount, std::forward<Args>(args)...);
+			++mCount;
+			return index;
+		}
+
+		// Built before growing or shifting, either of which could move an element args refers to.
+		T value(std::forward<Args>(args)...);
 		ensureCapacity(mCount + 1);
 
 		if (index < mCount)
 		{
-			std::uninitialized_move_n(mData + mCount - 1, 1, mData + mCount);
-			std::move_backward(mData + index, mData + mCount - 1, mData + mCount);
+			uninitializedMove(mData + mCount - 1, 1, mData + mCount);
+			++mCount;
+			std::move_backward(mData + index, mData + mCount - 2, mData + mCount - 1);
+			mData[index] = std::move(value);
+		}
+		else
+		{
+			std::construct_at(mData + mCount, std::move(value));
+			++mCount;
 		}
-		std::construct_at(mData + index, std::forward<Args>(args)...);
-		++mCount;
 
 		return index;
 	}
 
-	size_t Find(const T& value) const
+	constexpr size_t Find(const T& value) const
 	{
 		const T* it = std::find(mData, mData + mCount, value);
 		return it != mData + mCount ? static_cast<size_t>(it - mData) : INDEX_NONE;
 	}
 
 	template <typename Predicate>
-	size_t FindIf(Predicate pred) const
+	constexpr size_t FindIf(Predicate pred) const
 	{
 		const T* it = std::find_if(mData, mData + mCount, pred);
 		return it != mData + mCount ? static_cast<size_t>(it - mData) : INDEX_NONE;
 	}
 
-	size_t FindLast(const T& value) const
+	constexpr size_t FindLast(const T& value) const
 	{
 		for (size_t i = mCount; i-- > 0; )
 		{
@@ -241,7 +259,7 @@ public:
 	}
 
 	template <typename Predicate>
-	size_t FindLastIf(Predicate pred) const
+	constexpr size_t FindLastIf(Predicate pred) const
 	{
 		for (size_t i = mCount; i-- > 0; )
 		{
@@ -253,44 +271,44 @@ public:
 		return INDEX_NONE;
 	}
 
-	size_t Insert(size_t index, const T& value)
+	constexpr size_t Insert(size_t index, const T& value)
 	{
 		return EmplaceAt(index, value);
 	}
 
-	size_t Insert(size_t index, T&& value)
+	constexpr size_t Insert(size_t index, T&& value)
 	{
 		return EmplaceAt(index, std::move(value));
 	}
 
-	size_t Insert(size_t index, const Array& source)
+	constexpr size_t Insert(size_t index, const Array& source)
 	{
 		return insertImpl(index, source.mData, source.mCount);
 	}
 
-	size_t Insert(size_t index, Array&& source)
+	constexpr size_t Insert(size_t index, Array&& source)
 	{
 		size_t result = insertImpl(index, source.mData, source.mCount);
 		source.Clear();
 		return result;
 	}
 
-	size_t Insert(size_t index, std::initializer_list<T> ilist)
+	constexpr size_t Insert(size_t index, std::initializer_list<T> ilist)
 	{
 		return insertImpl(index, ilist.begin(), ilist.size());
 	}
 
-	size_t Insert(size_t index, const T* ptr, size_t count)
+	constexpr size_t Insert(size_t index, const T* ptr, size_t count)
 	{
 		return insertImpl(index, ptr, count);
 	}
 
-	bool IsEmpty() const noexcept
+	constexpr bool IsEmpty() const noexcept
 	{
 		return mCount == 0;
 	}
 
-	bool Remove(const T& value)
+	constexpr bool Remove(const T& value)
 	{
 		size_t index = Find(value);
 		if (index != INDEX_NONE)
@@ -302,7 +320,7 @@ public:
 	}
 
 	template <typename Predicate>
-	size_t RemoveAll(Predicate pred)
+	constexpr size_t RemoveAll(Predicate pred)
 	{
 		T* newEnd = std::remove_if(mData, mData + mCount, pred);
 		if (newEnd == mData + mCount)
@@ -315,7 +333,7 @@ public:
 		return removedCount;
 	}
 
-	void RemoveAt(size_t index)
+	constexpr void RemoveAt(size_t index)
 	{
 		checkRange(index);
 		std::destroy_at(mData + index);
@@ -326,7 +344,7 @@ public:
 		--mCount;
 	}
 
-	void Reserve(size_t newCapacity)
+	constexpr void Reserve(size_t newCapacity)
 	{
 		if (newCapacity > mCapacity)
 		{
@@ -334,17 +352,17 @@ public:
 		}
 	}
 
-	void Resize(size_t newCount)
+	constexpr void Resize(size_t newCount)
 	{
 		Resize(newCount, T());
 	}
 
-	void Resize(size_t newCount, const T& value)
+	constexpr void Resize(size_t newCount, const T& value)
 	{
 		if (newCount > mCount)
 		{
 			ensureCapacity(newCount);
-			std::uninitialized_fill_n(mData + mCount, newCount - mCount, value);
+			uninitializedFill(mData + mCount, newCount - mCount, value);
 		}
 		else if (newCount < mCount)
 		{
@@ -353,7 +371,15 @@ public:
 		mCount = newCount;
 	}
 
-	void Shrink()
+	// Grows or shrinks without initializing new elements, for callers that fill them directly
+	// (e.g. from a file read). Only offered where skipping construction is valid.
+	constexpr void ResizeUninitialized(size_t newCount) requires std::is_trivially_copyable_v<T>
+	{
+		ensureCapacity(newCount);
+		mCount = newCount;
+	}
+
+	constexpr void Shrink()
 	{
 		if (mCapacity > mCount)
 		{
@@ -362,12 +388,12 @@ public:
 	}
 
 	template <typename Compare>
-	void Sort(Compare comp)
+	constexpr void Sort(Compare comp)
 	{
 		std::sort(mData, mData + mCount, comp);
 	}
 
-	void Swap(Array& other) noexcept
+	constexpr void Swap(Array& other) noexcept
 	{
 		std::swap(mData, other.mData);
 		std::swap(mCount, other.mCount);
@@ -375,48 +401,90 @@ public:
 	}
 
 public: // Iterators for range-based loop support.
-	Iterator begin() noexcept
+	constexpr Iterator begin() noexcept
 	{
 		return Iterator(mData);
 	}
 
-	ConstIterator begin() const noexcept
+	constexpr ConstIterator begin() const noexcept
 	{
 		return ConstIterator(mData);
 	}
 
-	Iterator end() noexcept
+	constexpr Iterator end() noexcept
 	{
 		return Iterator(mData + mCount);
 	}
 
-	ConstIterator end() const noexcept
+	constexpr ConstIterator end() const noexcept
 	{
 		return ConstIterator(mData + mCount);
 	}
 
-	ReverseIterator rbegin() noexcept
+	constexpr ReverseIterator rbegin() noexcept
 	{
 		return ReverseIterator(end());
 	}
 
-	ConstReverseIterator rbegin() const noexcept
+	constexpr ConstReverseIterator rbegin() const noexcept
 	{
 		return ConstReverseIterator(end());
 	}
 
-	ReverseIterator rend() noexcept
+	constexpr ReverseIterator rend() noexcept
 	{
 		return ReverseIterator(begin());
 	}
 
-	ConstReverseIterator rend() const noexcept
+	constexpr ConstReverseIterator rend() const noexcept
 	{
 		return ConstReverseIterator(begin());
 	}
 
 private:
-	void checkRange(size_t index, bool bAllowEnd = false) const
+	// The std::uninitialized_* algorithms are not constexpr until C++26, so constant
+	// evaluation falls back to element-wise construct_at.
+	static constexpr void uninitializedCopy(const T* src, size_t count, T* dest)
+	{
+		if (std::is_constant_evaluated())
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				std::construct_at(dest + i, src[i]);
+			}
+			return;
+		}
+		std::uninitialized_copy_n(src, count, dest);
+	}
+
+	static constexpr void uninitializedMove(T* src, size_t count, T* dest)
+	{
+		if (std::is_constant_evaluated())
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				std::construct_at(dest + i, std::move(src[i]));
+			}
+			return;
+		}
+		std::uninitialized_move_n(src, count, dest);
+	}
+
+	static constexpr void uninitializedFill(T* dest, size_t count, const T& value)
+	{
+		if (std::is_constant_evaluated())
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				std::construct_at(dest + i, value);
+			}
+			return;
+		}
+		std::uninitialized_fill_n(dest, count, value);
+	}
+
+private:
+	constexpr void checkRange(size_t index, bool bAllowEnd = false) const
 	{
 		if (index >= mCount + (bAllowEnd ? 1 : 0))
 		{
@@ -424,7 +492,7 @@ private:
 		}
 	}
 
-	void ensureCapacity(size_t minCapacity)
+	constexpr void ensureCapacity(size_t minCapacity)
 	{
 		if (minCapacity > mCapacity)
 		{
@@ -434,7 +502,7 @@ private:
 		}
 	}
 
-	size_t insertImpl(size_t index, const T* ptr, size_t count)
+	constexpr size_t insertImpl(size_t index, const T* ptr, size_t count)
 	{
 		checkRange(index, true);
 
@@ -445,18 +513,19 @@ private:
 
 		ensureCapacity(mCount + count);
 
-		if (index < mCount)
-		{
-			std::uninitialized_move_n(mData + mCount - count, count, mData + mCount);
-			std::move_backward(mData + index, mData + mCount - count, mData + mCount);
-		}
-		std::uninitialized_copy_n(ptr, count, mData + index);
+		// The last `moved` elements land in raw storage; the rest shift within live slots. The
+		// gap then holds `moved` moved-from elements to assign and raw slots to construct.
+		size_t moved = std::min(mCount - index, count);
+		uninitializedMove(mData + mCount - moved, moved, mData + mCount + count - moved);
+		std::move_backward(mData + index, mData + mCount - moved, mData + mCount + count - moved);
+		std::copy_n(ptr, moved, mData + index);
+		uninitializedCopy(ptr + moved, count - moved, mData + index + moved);
 		mCount += count;
 
 		return index;
 	}
 
-	void reallocate(size_t newCapacity)
+	constexpr void reallocate(size_t newCapacity)
 	{
 		if (newCapacity == mCapacity)
 		{
@@ -469,14 +538,14 @@ private:
 			return;
 		}
 
-		T* newData = static_cast<T*>(::operator new(sizeof(T) * newCapacity));
+		T* newData = std::allocator<T>().allocate(newCapacity);
 		size_t newCount = std::min(mCount, newCapacity);
 
 		if (mData)
 		{
-			std::uninitialized_move_n(mData, newCount, newData);
+			uninitializedMove(mData, newCount, newData);
 			std::destroy_n(mData, mCount);
-			::operator delete(mData);
+			std::allocator<T>().deallocate(mData, mCapacity);
 		}
 
 		mData = newData;
@@ -484,12 +553,12 @@ private:
 		mCapacity = newCapacity;
 	}
 
-	void cleanup() noexcept
+	constexpr void cleanup() noexcept
 	{
 		if (mData)
 		{
 			std::destroy_n(mData, mCount);
-			::operator delete(mData);
+			std::allocator<T>().deallocate(mData, mCapacity);
 			mData = nullptr;
 			mCount = 0;
 			mCapacity = 0;
@@ -506,91 +575,132 @@ template <typename T>
 class ArrayIterator
 {
 public:
-	ArrayIterator() noexcept
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = std::remove_const_t<T>;
+	using difference_type = ptrdiff_t;
+	using pointer = T*;
+	using reference = T&;
+
+public:
+	constexpr ArrayIterator() noexcept
 		: mPtr(nullptr)
 	{
 	}
 
-	explicit ArrayIterator(T* ptr) noexcept
+	constexpr explicit ArrayIterator(T* ptr) noexcept
 		: mPtr(ptr)
 	{
 	}
 
 	template<typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
-	ArrayIterator(const ArrayIterator<std::remove_const_t<T>>& other) noexcept
+	constexpr ArrayIterator(const ArrayIterator<std::remove_const_t<T>>& other) noexcept
 		: mPtr(other.mPtr)
 	{
 	}
 
 public:
-	T& operator*() const noexcept
+	constexpr T& operator*() const noexcept
 	{
 		return *mPtr;
 	}
 
-	T* operator->() const noexcept
+	constexpr T* operator->() const noexcept
 	{
 		return mPtr;
 	}
 
-	T& operator[](size_t index) const noexcept
+	constexpr T& operator[](size_t index) const noexcept
 	{
 		return *(mPtr + index);
 	}
 
-	ArrayIterator& operator++() noexcept
+	constexpr ArrayIterator& operator++() noexcept
 	{
 		++mPtr;
 		return *this;
 	}
 
-	ArrayIterator operator++(int) noexcept
+	constexpr ArrayIterator operator++(int) noexcept
 	{
 		ArrayIterator temp = *this;
 		++mPtr;
 		return temp;
 	}
 
-	ArrayIterator& operator--() noexcept
+	constexpr ArrayIterator& operator--() noexcept
 	{
 		--mPtr;
 		return *this;
 	}
 
-	ArrayIterator operator--(int) noexcept
+	constexpr ArrayIterator operator--(int) noexcept
 	{
 		ArrayIterator temp = *this;
 		--mPtr;
 		return temp;
 	}
 
-	ArrayIterator operator+(size_t n) const noexcept
+	constexpr ArrayIterator& operator+=(ptrdiff_t n) noexcept
+	{
+		mPtr += n;
+		return *this;
+	}
+
+	constexpr ArrayIterator& operator-=(ptrdiff_t n) noexcept
+	{
+		mPtr -= n;
+		return *this;
+	}
+
+	constexpr ArrayIterator operator+(size_t n) const noexcept
 	{
 		return ArrayIterator(mPtr + n);
 	}
 
-	ArrayIterator operator-(size_t n) const noexcept
+	constexpr ArrayIterator operator-(size_t n) const noexcept
 	{
 		return ArrayIterator(mPtr - n);
 	}
 
-	ptrdiff_t operator-(const ArrayIterator& other) const noexcept
+	constexpr ptrdiff_t operator-(const ArrayIterator& other) const noexcept
 	{
 		return mPtr - other.mPtr;
 	}
 
-	bool operator==(const ArrayIterator& other) const noexcept
+	constexpr bool operator==(const ArrayIterator& other) const noexcept
 	{
 		return mPtr == other.mPtr;
 	}
 
-	bool operator!=(const ArrayIterator& other) const noexcept
+	constexpr bool operator!=(const ArrayIterator& other) const noexcept
 	{
 		return mPtr != other.mPtr;
 	}
 
+	constexpr std::strong_ordering operator<=>(const ArrayIterator& other) const noexcept
+	{
+		return mPtr <=> other.mPtr;
+	}
+
 private:
+	friend class ArrayIterator<const T>;
+
 	T* mPtr;
 };
 
+// Runs a constexpr generator that builds an Array and bakes the result into a std::array, so
+// lookup tables can be built with the full Array API at compile time and cost nothing at startup.
+// The generator runs twice: once to size the table and once to fill it.
+template <auto Generator>
+consteval auto FreezeArray()
+{
+	using Value = typename decltype(Generator())::Iterator::value_type;
+	constexpr size_t count = Generator().Count();
+
+	std::array<Value, count> table{};
+	auto source = Generator();
+	std::copy_n(source.Data(), count, table.begin());
+	return table;
+}
+
 } // namespace abouttt
@@ -0,0 +1,346 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+// Binary persistence for Arrays of trivially copyable elements. A file is a fixed 64-byte
+// header, zero padding up to PayloadOffset, then the raw element bytes. The payload moves with
+// a single writev/read straight to and from Data(), looping only on short transfers.
+class ArrayFile
+{
+public:
+	struct Header
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t ElementSize;
+		uint32_t ElementAlignment;
+		uint64_t PayloadOffset;
+		uint64_t Count;
+		uint64_t Checksum;
+		uint64_t HeaderChecksum;
+		uint64_t Reserved[2];
+	};
+
+	static_assert(sizeof(Header) == 64, "ArrayFile header layout must stay fixed");
+
+	// Streaming form of Checksum for payloads that only grow: Consume hashes whole 32-byte
+	// blocks as they arrive and Finish folds in the remaining tail without changing the state,
+	// so appending more bytes and finishing again costs only the new bytes.
+	class ChecksumState
+	{
+	public:
+		ChecksumState() noexcept
+			: mLanes{ PRIME_1 + PRIME_2, PRIME_2, 0, 0 - PRIME_1 }
+			, mConsumedBytes(0)
+		{
+		}
+
+	public:
+		// Hashes the whole blocks of data and returns how many bytes that was.
+		size_t Consume(const void* data, size_t size) noexcept
+		{
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			size_t i = 0;
+			for (; i + 32 <= size; i += 32)
+			{
+				for (size_t lane = 0; lane < 4; ++lane)
+				{
+					mLanes[lane] = mixRound(mLanes[lane], loadWord(bytes + i + lane * 8));
+				}
+			}
+			mConsumedBytes += i;
+			return i;
+		}
+
+		size_t ConsumedBytes() const noexcept
+		{
+			return mConsumedBytes;
+		}
+
+		// Returns the checksum of everything consumed followed by the size tail bytes.
+		uint64_t Finish(const void* tail, size_t size) const noexcept
+		{
+			const unsigned char* bytes = static_cast<const unsigned char*>(tail);
+			uint64_t hash = std::rotl(mLanes[0], 1) + std::rotl(mLanes[1], 7) + std::rotl(mLanes[2], 12) + std::rotl(mLanes[3], 18);
+
+			size_t i = 0;
+			for (; i + 8 <= size; i += 8)
+			{
+				hash = std::rotl(hash ^ mixRound(0, loadWord(bytes + i)), 27) * PRIME_1 + PRIME_2;
+			}
+			for (; i < size; ++i)
+			{
+				hash = std::rotl(hash ^ (bytes[i] * PRIME_1), 11) * PRIME_2;
+			}
+			return finalize(hash ^ (mConsumedBytes + size));
+		}
+
+	private:
+		uint64_t mLanes[4];
+		size_t mConsumedBytes;
+	};
+
+public:
+	static constexpr uint32_t MAGIC = 0x59524241; // "ABRY" little-endian
+	static constexpr uint32_t VERSION = 1;
+
+public:
+	// A 64-bit checksum over four independent multiply-rotate lanes, so the hashing keeps up
+	// with sequential I/O.
+	static uint64_t Checksum(const void* data, size_t size) noexcept
+	{
+		ChecksumState state;
+		size_t consumed = state.Consume(data, size);
+		return state.Finish(static_cast<const unsigned char*>(data) + consumed, size - consumed);
+	}
+
+	template <typename T>
+	static Header MakeHeader(const T* data, size_t count) noexcept
+	{
+		return MakeHeaderWithChecksum<T>(count, Checksum(data, sizeof(T) * count));
+	}
+
+	// For writers that already hold the payload checksum, e.g. from a ChecksumState.
+	template <typename T>
+	static Header MakeHeaderWithChecksum(size_t count, uint64_t checksum) noexcept
+	{
+		Header header = {};
+		header.Magic = MAGIC;
+		header.Version = VERSION;
+		header.ElementSize = static_cast<uint32_t>(sizeof(T));
+		header.ElementAlignment = static_cast<uint32_t>(alignof(T));
+		header.PayloadOffset = PayloadOffset<T>();
+		header.Count = count;
+		header.Checksum = checksum;
+		header.HeaderChecksum = HeaderChecksum(header);
+		return header;
+	}
+
+	static uint64_t HeaderChecksum(const Header& header) noexcept
+	{
+		return Checksum(&header, offsetof(Header, HeaderChecksum));
+	}
+
+	// Verifies the header describes an Array<T> and returns its element count. Does not touch
+	// the payload checksum, which needs the payload.
+	template <typename T>
+	static size_t CheckHeader(const Header& header)
+	{
+		if (header.Magic != MAGIC || header.Version != VERSION || header.HeaderChecksum != HeaderChecksum(header))
+		{
+			throw std::runtime_error("ArrayFile header is corrupt or unsupported");
+		}
+		if (header.ElementSize != sizeof(T) || header.ElementAlignment != alignof(T) || header.PayloadOffset != PayloadOffset<T>())
+		{
+			throw std::runtime_error("ArrayFile element layout does not match");
+		}
+		return static_cast<size_t>(header.Count);
+	}
+
+	template <typename T>
+	static Array<T> Load(int fd, bool bVerifyChecksum = true)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "ArrayFile stores raw element bytes");
+
+		Header header;
+		readAll(fd, &header, sizeof(Header));
+		size_t count = CheckHeader<T>(header);
+
+		unsigned char padding[PAYLOAD_ALIGNMENT_MAX];
+		for (size_t remaining = header.PayloadOffset - sizeof(Header); remaining > 0; )
+		{
+			size_t chunk = std::min(remaining, sizeof(padding));
+			readAll(fd, padding, chunk);
+			remaining -= chunk;
+		}
+
+		Array<T> result;
+		result.ResizeUninitialized(count);
+		readAll(fd, result.Data(), sizeof(T) * count);
+
+		if (bVerifyChecksum && Checksum(result.Data(), sizeof(T) * count) != header.Checksum)
+		{
+			throw std::runtime_error("ArrayFile payload checksum mismatch");
+		}
+		return result;
+	}
+
+	template <typename T>
+	static Array<T> Load(const char* path, bool bVerifyChecksum = true)
+	{
+		ScopedFd file(openFile(path, O_RDONLY));
+		return Load<T>(file.Get(), bVerifyChecksum);
+	}
+
+	template <typename T>
+	static constexpr uint64_t PayloadOffset() noexcept
+	{
+		static_assert(alignof(T) <= PAYLOAD_ALIGNMENT_MAX, "ArrayFile payload alignment is limited to a page");
+		return std::max<uint64_t>(sizeof(Header), alignof(T));
+	}
+
+	template <typename T>
+	static void Save(const Array<T>& array, int fd)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "ArrayFile stores raw element bytes");
+
+		Header header = MakeHeader(array.Data(), array.Count());
+		static const unsigned char padding[PAYLOAD_ALIGNMENT_MAX] = {};
+
+		iovec parts[3] = {
+			{ &header, sizeof(Header) },
+			{ const_cast<unsigned char*>(padding), static_cast<size_t>(header.PayloadOffset) - sizeof(Header) },
+			{ const_cast<T*>(array.Data()), sizeof(T) * array.Count() },
+		};
+		writeAll(fd, parts, 3);
+	}
+
+	template <typename T>
+	static void Save(const Array<T>& array, const char* path)
+	{
+		ScopedFd file(openFile(path, O_WRONLY | O_CREAT | O_TRUNC));
+		Save(array, file.Get());
+	}
+
+private:
+	static constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ull;
+	static constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+	static constexpr size_t PAYLOAD_ALIGNMENT_MAX = 4096;
+
+	// Owns a descriptor opened by one of the path overloads.
+	class ScopedFd
+	{
+	public:
+		explicit ScopedFd(int fd) noexcept
+			: mFd(fd)
+		{
+		}
+
+		ScopedFd(const ScopedFd&) = delete;
+		ScopedFd& operator=(const ScopedFd&) = delete;
+
+		~ScopedFd()
+		{
+			::close(mFd);
+		}
+
+	public:
+		int Get() const noexcept
+		{
+			return mFd;
+		}
+
+	private:
+		int mFd;
+	};
+
+	static uint64_t loadWord(const unsigned char* ptr) noexcept
+	{
+		uint64_t word;
+		std::memcpy(&word, ptr, sizeof(word));
+		return word;
+	}
+
+	static uint64_t mixRound(uint64_t lane, uint64_t word) noexcept
+	{
+		return std::rotl(lane + word * PRIME_2, 31) * PRIME_1;
+	}
+
+	static uint64_t finalize(uint64_t hash) noexcept
+	{
+		hash ^= hash >> 33;
+		hash *= PRIME_2;
+		hash ^= hash >> 29;
+		hash *= PRIME_1;
+		return hash ^ (hash >> 32);
+	}
+
+	static int openFile(const char* path, int flags)
+	{
+		int fd = ::open(path, flags | O_CLOEXEC, 0644);
+		if (fd < 0)
+		{
+			throw std::system_error(errno, std::generic_category(), "ArrayFile open failed");
+		}
+		return fd;
+	}
+
+	static void readAll(int fd, void* data, size_t size)
+	{
+		unsigned char* cursor = static_cast<unsigned char*>(data);
+		while (size > 0)
+		{
+			ssize_t result = ::read(fd, cursor, size);
+			if (result < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (result < 0)
+			{
+				throw std::system_error(errno, std::generic_category(), "ArrayFile read failed");
+			}
+			if (result == 0)
+			{
+				throw std::runtime_error("ArrayFile is truncated");
+			}
+			cursor += result;
+			size -= static_cast<size_t>(result);
+		}
+	}
+
+	// Resubmits whatever a short writev left behind, advancing through the iovec list.
+	static void writeAll(int fd, iovec* parts, int partCount)
+	{
+		while (partCount > 0)
+		{
+			if (parts->iov_len == 0)
+			{
+				++parts;
+				--partCount;
+				continue;
+			}
+
+			ssize_t result = ::writev(fd, parts, partCount);
+			if (result < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (result < 0)
+			{
+				throw std::system_error(errno, std::generic_category(), "ArrayFile write failed");
+			}
+
+			size_t written = static_cast<size_t>(result);
+			while (partCount > 0 && written >= parts->iov_len)
+			{
+				written -= parts->iov_len;
+				++parts;
+				--partCount;
+			}
+			if (partCount > 0)
+			{
+				parts->iov_base = static_cast<unsigned char*>(parts->iov_base) + written;
+				parts->iov_len -= written;
+			}
+		}
+	}
+};
+
+} // namespace abouttt
@@ -0,0 +1,774 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+// <linux/io_uring.h> is not included because it drags in <linux/fs.h>, whose BLOCK_SIZE macro
+// breaks unrelated headers; IoUring declares the few ABI structs it needs itself.
+#if defined(__linux__) && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define ABOUTTT_HAS_IO_URING 1
+#else
+#define ABOUTTT_HAS_IO_URING 0
+#endif
+
+#include "Array.h"
+#include "ArrayFile.h"
+
+namespace abouttt
+{
+
+struct ArrayLoadOptions
+{
+	size_t ChunkBytes = 1024 * 1024;
+	unsigned QueueDepth = 32;
+	size_t ThreadCount = 0; // preadv fallback workers; 0 picks the hardware concurrency
+	bool bDirect = false;
+	bool bUseIoUring = true;
+	bool bVerifyChecksum = true;
+};
+
+// Loads a file written by ArrayFile::Save with many reads in flight at once, which a single
+// blocking read cannot do. The payload is split into ChunkBytes reads that land directly in
+// the pre-sized Array. They are queued through io_uring where the kernel allows it. Otherwise
+// a pool of threads issues them with preadv.
+//
+// With bDirect the file is opened O_DIRECT, bypassing the page cache. Reads then go through
+// page-aligned bounce buffers, because the payload does not start on a block boundary. File
+// systems that refuse O_DIRECT are read buffered instead.
+template <typename T>
+class ArrayLoader
+{
+	static_assert(std::is_trivially_copyable_v<T>, "ArrayLoader reads raw element bytes");
+
+public:
+	static constexpr size_t DIRECT_ALIGNMENT = 4096;
+
+public:
+	static Array<T> Load(const char* path, const ArrayLoadOptions& options = {})
+	{
+		bool bDirect = options.bDirect;
+		int fd = openFile(path, bDirect);
+		try
+		{
+			Array<T> result = load(fd, bDirect, options);
+			::close(fd);
+			return result;
+		}
+		catch (...)
+		{
+			::close(fd);
+			throw;
+		}
+	}
+
+	static std::future<Array<T>> LoadAsync(std::string path, ArrayLoadOptions options = {})
+	{
+		return std::async(std::launch::async, [path = std::move(path), options]()
+		{
+			return Load(path.c_str(), options);
+		});
+	}
+
+	// Runs onComplete(Array<T>&&, std::exception_ptr) on the loading thread when done. The
+	// exception_ptr is null on success.
+	template <typename Callback>
+		requires std::invocable<Callback&, Array<T>&&, std::exception_ptr>
+	static std::future<void> LoadAsync(std::string path, Callback onComplete, ArrayLoadOptions options = {})
+	{
+		return std::async(std::launch::async, [path = std::move(path), onComplete = std::move(onComplete), options]() mutable
+		{
+			Array<T> result;
+			std::exception_ptr error;
+			try
+			{
+				result = Load(path.c_str(), options);
+			}
+			catch (...)
+			{
+				error = std::current_exception();
+			}
+			onComplete(std::move(result), error);
+		});
+	}
+
+private:
+	// A chunk of the file. In direct mode, the read covers whole aligned blocks. The copy takes
+	// the CopyLength bytes after Skip into Dest. Otherwise the read goes straight to Dest.
+	struct ReadTask
+	{
+		uint64_t FileOffset;
+		size_t Length;
+		size_t Skip;
+		size_t CopyLength;
+		std::byte* Dest;
+	};
+
+	class AlignedBuffer
+	{
+	public:
+		explicit AlignedBuffer(size_t size)
+			: mData(size > 0 ? static_cast<std::byte*>(::operator new(size, std::align_val_t(DIRECT_ALIGNMENT))) : nullptr)
+		{
+		}
+
+		AlignedBuffer(const AlignedBuffer&) = delete;
+		AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+		~AlignedBuffer()
+		{
+			if (mData)
+			{
+				::operator delete(mData, std::align_val_t(DIRECT_ALIGNMENT));
+			}
+		}
+
+	public:
+		std::byte* Data() const noexcept
+		{
+			return mData;
+		}
+
+	private:
+		std::byte* mData;
+	};
+
+	static int openFile(const char* path, bool& bDirect)
+	{
+		int fd = -1;
+#ifdef O_DIRECT
+		if (bDirect)
+		{
+			fd = ::open(path, O_RDONLY | O_CLOEXEC | O_DIRECT);
+			if (fd < 0 && errno != EINVAL)
+			{
+				throw std::system_error(errno, std::generic_category(), "ArrayLoader open failed");
+			}
+		}
+#endif
+		if (fd < 0)
+		{
+			bDirect = false;
+			fd = ::open(path, O_RDONLY | O_CLOEXEC);
+			if (fd < 0)
+			{
+				throw std::system_error(errno, std::generic_category(), "ArrayLoader open failed");
+			}
+		}
+		return fd;
+	}
+
+	static Array<T> load(int fd, bool bDirect, const ArrayLoadOptions& options)
+	{
+		ArrayFile::Header header;
+		{
+			AlignedBuffer block(DIRECT_ALIGNMENT);
+			ReadTask task{ 0, DIRECT_ALIGNMENT, 0, sizeof(header), reinterpret_cast<std::byte*>(&header) };
+			readBlocking(fd, task, sizeof(header), block.Data(), true);
+		}
+		size_t count = ArrayFile::CheckHeader<T>(header);
+
+		Array<T> result;
+		result.ResizeUninitialized(count);
+
+		size_t chunkBytes = (std::max(options.ChunkBytes, DIRECT_ALIGNMENT) + DIRECT_ALIGNMENT - 1) / DIRECT_ALIGNMENT * DIRECT_ALIGNMENT;
+		Array<ReadTask> tasks = planReads(header.PayloadOffset, sizeof(T) * count, reinterpret_cast<std::byte*>(result.Data()), chunkBytes, bDirect);
+
+		bool bLoaded = false;
+#if ABOUTTT_HAS_IO_URING
+		if (options.bUseIoUring)
+		{
+			bLoaded = readWithIoUring(fd, tasks, chunkBytes, std::max(1u, options.QueueDepth), bDirect);
+		}
+#endif
+		if (!bLoaded)
+		{
+			readWithThreads(fd, tasks, chunkBytes, options.ThreadCount, bDirect);
+		}
+
+		if (options.bVerifyChecksum && ArrayFile::Checksum(result.Data(), sizeof(T) * count) != header.Checksum)
+		{
+			throw std::runtime_error("ArrayFile payload checksum mismatch");
+		}
+		return result;
+	}
+
+	static Array<ReadTask> planReads(uint64_t payloadOffset, size_t payloadBytes, std::byte* dest, size_t chunkBytes, bool bDirect)
+	{
+		Array<ReadTask> tasks;
+		uint64_t payloadEnd = payloadOffset + payloadBytes;
+		uint64_t start = bDirect ? payloadOffset / DIRECT_ALIGNMENT * DIRECT_ALIGNMENT : payloadOffset;
+		tasks.Reserve(static_cast<size_t>((payloadEnd - start + chunkBytes - 1) / chunkBytes));
+
+		for (uint64_t offset = start; offset < payloadEnd; offset += chunkBytes)
+		{
+			uint64_t copyStart = std::max(offset, payloadOffset);
+			size_t copyLength = static_cast<size_t>(std::min<uint64_t>(offset + chunkBytes, payloadEnd) - copyStart);
+			size_t skip = static_cast<size_t>(copyStart - offset);
+			size_t length = bDirect
+				? (skip + copyLength + DIRECT_ALIGNMENT - 1) / DIRECT_ALIGNMENT * DIRECT_ALIGNMENT
+				: copyLength;
+			tasks.Add(ReadTask{ offset, length, skip, copyLength, dest + (copyStart - payloadOffset) });
+		}
+		return tasks;
+	}
+
+	static std::byte* readTarget(const ReadTask& task, std::byte* bounce, bool bDirect) noexcept
+	{
+		return bDirect ? bounce : task.Dest;
+	}
+
+	// Bytes the read must deliver before the chunk is complete; direct reads may stop short of
+	// their rounded-up length at end of file.
+	static size_t requiredBytes(const ReadTask& task) noexcept
+	{
+		return task.Skip + task.CopyLength;
+	}
+
+	static void finishRead(const ReadTask& task, const std::byte* bounce, bool bDirect) noexcept
+	{
+		if (bDirect)
+		{
+			std::memcpy(task.Dest, bounce + task.Skip, task.CopyLength);
+		}
+	}
+
+	static void readBlocking(int fd, const ReadTask& task, size_t required, std::byte* bounce, bool bDirect)
+	{
+		std::byte* target = readTarget(task, bounce, bDirect);
+		size_t filled = 0;
+		while (filled < required)
+		{
+			iovec part = { target + filled, task.Length - filled };
+			ssize_t result = ::preadv(fd, &part, 1, static_cast<off_t>(task.FileOffset + filled));
+			if (result < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (result < 0)
+			{
+				throw std::system_error(errno, std::generic_category(), "ArrayLoader read failed");
+			}
+			if (result == 0)
+			{
+				throw std::runtime_error("ArrayFile is truncated");
+			}
+			filled += static_cast<size_t>(result);
+		}
+		finishRead(task, bounce, bDirect);
+	}
+
+	// Workers claim chunks from a shared counter; the first error stops further claims and is
+	// rethrown once every worker has joined.
+	static void readWithThreads(int fd, const Array<ReadTask>& tasks, size_t chunkBytes, size_t threadCount, bool bDirect)
+	{
+		if (threadCount == 0)
+		{
+			threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+		}
+		threadCount = std::max<size_t>(1, std::min(threadCount, tasks.Count()));
+
+		std::atomic<size_t> nextTask(0);
+		std::atomic<bool> bFailed(false);
+		std::exception_ptr firstError;
+		std::mutex errorMutex;
+
+		auto work = [&]()
+		{
+			try
+			{
+				AlignedBuffer bounce(bDirect ? chunkBytes : 0);
+				for (size_t i = nextTask++; i < tasks.Count() && !bFailed; i = nextTask++)
+				{
+					readBlocking(fd, tasks.Data()[i], requiredBytes(tasks.Data()[i]), bounce.Data(), bDirect);
+				}
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if (!firstError)
+				{
+					firstError = std::current_exception();
+				}
+				bFailed = true;
+			}
+		};
+
+		Array<std::thread> workers(threadCount - 1);
+		auto joinAll = [&workers]()
+		{
+			for (std::thread& worker : workers)
+			{
+				worker.join();
+			}
+		};
+
+		// If a spawn fails, the running workers are stopped and joined before the error
+		// propagates; destroying a joinable std::thread would terminate.
+		try
+		{
+			for (size_t i = 1; i < threadCount; ++i)
+			{
+				workers.Emplace(work);
+			}
+		}
+		catch (...)
+		{
+			bFailed = true;
+			joinAll();
+			throw;
+		}
+		work();
+		joinAll();
+
+		if (firstError)
+		{
+			std::rethrow_exception(firstError);
+		}
+	}
+
+#if ABOUTTT_HAS_IO_URING
+	// Minimal io_uring wrapper over the raw syscalls: one submission and one completion ring,
+	// driven from a single thread.
+	class IoUring
+	{
+	public:
+		explicit IoUring(unsigned entries)
+			: mFd(-1)
+			, mSqRing(MAP_FAILED)
+			, mCqRing(MAP_FAILED)
+			, mSqes(MAP_FAILED)
+			, mParams()
+			, mSqTail(0)
+			, mUnsubmitted(0)
+		{
+			mFd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &mParams));
+			if (mFd < 0)
+			{
+				throw std::system_error(errno, std::generic_category(), "io_uring_setup failed");
+			}
+
+			try
+			{
+				mSqRing = mapRing(sqRingSize(), OFF_SQ_RING);
+				mCqRing = mapRing(cqRingSize(), OFF_CQ_RING);
+				mSqes = mapRing(mParams.SqEntries * sizeof(Sqe), OFF_SQES);
+			}
+			catch (...)
+			{
+				cleanup();
+				throw;
+			}
+			mSqTail = *sqField(mParams.SqOff.Tail);
+		}
+
+		IoUring(const IoUring&) = delete;
+		IoUring& operator=(const IoUring&) = delete;
+
+		~IoUring()
+		{
+			cleanup();
+		}
+
+	public:
+		unsigned Capacity() const noexcept
+		{
+			return mParams.SqEntries;
+		}
+
+		// Withdraws reads that are queued but not yet taken by the kernel, so they never
+		// start, and returns how many there were.
+		unsigned DiscardUnsubmitted() noexcept
+		{
+			unsigned head = std::atomic_ref<unsigned>(*sqField(mParams.SqOff.Head)).load(std::memory_order_acquire);
+			unsigned discarded = mSqTail - head;
+			mSqTail = head;
+			mUnsubmitted = 0;
+			std::atomic_ref<unsigned>(*sqField(mParams.SqOff.Tail)).store(mSqTail, std::memory_order_release);
+			return discarded;
+		}
+
+		// Queues a readv of one iovec; the iovec must stay alive until its completion.
+		void QueueRead(int fd, const iovec* part, uint64_t offset, uint64_t userData) noexcept
+		{
+			unsigned index = mSqTail & *sqField(mParams.SqOff.RingMask);
+			Sqe& sqe = static_cast<Sqe*>(mSqes)[index];
+			std::memset(&sqe, 0, sizeof(sqe));
+			sqe.Opcode = OP_READV;
+			sqe.Fd = fd;
+			sqe.Offset = offset;
+			sqe.Address = reinterpret_cast<uint64_t>(part);
+			sqe.Length = 1;
+			sqe.UserData = userData;
+
+			sqField(mParams.SqOff.Array)[index] = index;
+			++mSqTail;
+			++mUnsubmitted;
+		}
+
+		// Publishes queued reads and blocks until at least minComplete completions are ready.
+		void SubmitAndWait(unsigned minComplete)
+		{
+			std::atomic_ref<unsigned>(*sqField(mParams.SqOff.Tail)).store(mSqTail, std::memory_order_release);
+			mUnsubmitted -= enter(mUnsubmitted, minComplete);
+		}
+
+		// Blocks until at least minComplete completions are ready without submitting anything.
+		void Wait(unsigned minComplete)
+		{
+			enter(0, minComplete);
+		}
+
+		template <typename Function>
+		void ForEachCompletion(Function func) noexcept
+		{
+			unsigned* headField = cqField(mParams.CqOff.Head);
+			unsigned head = *headField;
+			unsigned tail = std::atomic_ref<unsigned>(*cqField(mParams.CqOff.Tail)).load(std::memory_order_acquire);
+			unsigned mask = *cqField(mParams.CqOff.RingMask);
+			const Cqe* cqes = reinterpret_cast<const Cqe*>(static_cast<std::byte*>(mCqRing) + mParams.CqOff.Cqes);
+
+			for (; head != tail; ++head)
+			{
+				const Cqe& cqe = cqes[head & mask];
+				func(cqe.UserData, cqe.Result);
+			}
+			std::atomic_ref<unsigned>(*headField).store(head, std::memory_order_release);
+		}
+
+	private:
+		// Kernel ABI, mirroring struct io_uring_params, io_uring_sqe and io_uring_cqe.
+		struct SqRingOffsets
+		{
+			uint32_t Head;
+			uint32_t Tail;
+			uint32_t RingMask;
+			uint32_t RingEntries;
+			uint32_t Flags;
+			uint32_t Dropped;
+			uint32_t Array;
+			uint32_t Reserved1;
+			uint64_t UserAddress;
+		};
+
+		struct CqRingOffsets
+		{
+			uint32_t Head;
+			uint32_t Tail;
+			uint32_t RingMask;
+			uint32_t RingEntries;
+			uint32_t Overflow;
+			uint32_t Cqes;
+			uint32_t Flags;
+			uint32_t Reserved1;
+			uint64_t UserAddress;
+		};
+
+		struct Params
+		{
+			uint32_t SqEntries;
+			uint32_t CqEntries;
+			uint32_t Flags;
+			uint32_t SqThreadCpu;
+			uint32_t SqThreadIdle;
+			uint32_t Features;
+			uint32_t WqFd;
+			uint32_t Reserved[3];
+			SqRingOffsets SqOff;
+			CqRingOffsets CqOff;
+		};
+
+		struct Sqe
+		{
+			uint8_t Opcode;
+			uint8_t Flags;
+			uint16_t IoPriority;
+			int32_t Fd;
+			uint64_t Offset;
+			uint64_t Address;
+			uint32_t Length;
+			uint32_t RwFlags;
+			uint64_t UserData;
+			uint16_t BufferIndex;
+			uint16_t Personality;
+			int32_t SpliceFdIn;
+			uint64_t Padding[2];
+		};
+
+		struct Cqe
+		{
+			uint64_t UserData;
+			int32_t Result;
+			uint32_t Flags;
+		};
+
+		static_assert(sizeof(Params) == 120 && sizeof(Sqe) == 64 && sizeof(Cqe) == 16, "io_uring ABI layout mismatch");
+
+		static constexpr off_t OFF_SQ_RING = 0;
+		static constexpr off_t OFF_CQ_RING = 0x8000000;
+		static constexpr off_t OFF_SQES = 0x10000000;
+		static constexpr uint8_t OP_READV = 1;
+		static constexpr unsigned ENTER_GETEVENTS = 1;
+
+		unsigned enter(unsigned toSubmit, unsigned minComplete)
+		{
+			while (true)
+			{
+				long result = ::syscall(__NR_io_uring_enter, mFd, toSubmit, minComplete, ENTER_GETEVENTS, nullptr, 0);
+				if (result >= 0)
+				{
+					return static_cast<unsigned>(result);
+				}
+				if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+				{
+					throw std::system_error(errno, std::generic_category(), "io_uring_enter failed");
+				}
+			}
+		}
+
+		void* mapRing(size_t size, off_t offset)
+		{
+			void* ring = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mFd, offset);
+			if (ring == MAP_FAILED)
+			{
+				throw std::system_error(errno, std::generic_category(), "io_uring mmap failed");
+			}
+			return ring;
+		}
+
+		size_t sqRingSize() const noexcept
+		{
+			return mParams.SqOff.Array + mParams.SqEntries * sizeof(unsigned);
+		}
+
+		size_t cqRingSize() const noexcept
+		{
+			return mParams.CqOff.Cqes + mParams.CqEntries * sizeof(Cqe);
+		}
+
+		void cleanup() noexcept
+		{
+			unmapRing(mSqes, mParams.SqEntries * sizeof(Sqe));
+			unmapRing(mCqRing, cqRingSize());
+			unmapRing(mSqRing, sqRingSize());
+			::close(mFd);
+		}
+
+		static void unmapRing(void*& ring, size_t size) noexcept
+		{
+			if (ring != MAP_FAILED)
+			{
+				::munmap(ring, size);
+				ring = MAP_FAILED;
+			}
+		}
+
+		unsigned* sqField(uint32_t offset) const noexcept
+		{
+			return reinterpret_cast<unsigned*>(static_cast<std::byte*>(mSqRing) + offset);
+		}
+
+		unsigned* cqField(uint32_t offset) const noexcept
+		{
+			return reinterpret_cast<unsigned*>(static_cast<std::byte*>(mCqRing) + offset);
+		}
+
+	private:
+		int mFd;
+		void* mSqRing;
+		void* mCqRing;
+		void* mSqes;
+		Params mParams;
+		unsigned mSqTail;
+		unsigned mUnsubmitted;
+	};
+
+	// Keeps up to queueDepth chunk reads in flight, requeueing short reads for their remainder.
+	// On any failure, a failed completion or io_uring_enter itself, it stops issuing reads and
+	// reaps every read the kernel accepted before throwing, so the kernel never writes into
+	// freed buffers. Returns false if io_uring is unavailable or rejects the read
+	// opcode before anything completes, leaving the caller to fall back.
+	static bool readWithIoUring(int fd, const Array<ReadTask>& tasks, size_t chunkBytes, unsigned queueDepth, bool bDirect)
+	{
+		size_t taskCount = tasks.Count();
+		if (taskCount == 0)
+		{
+			return true;
+		}
+
+		unsigned depth = static_cast<unsigned>(std::min<size_t>(queueDepth, taskCount));
+		std::optional<IoUring> ring;
+		try
+		{
+			ring.emplace(depth);
+		}
+		catch (const std::system_error&)
+		{
+			return false;
+		}
+		depth = std::min(depth, ring->Capacity());
+
+		AlignedBuffer bounce(bDirect ? chunkBytes * depth : 0);
+		// Completion handling must not allocate, so both lists are sized for a full queue.
+		Array<unsigned> freeSlots(depth);
+		Array<size_t> requeue(depth);
+		for (unsigned slot = depth; slot-- > 0; )
+		{
+			freeSlots.Add(slot);
+		}
+
+		Array<iovec> parts;
+		Array<size_t> filled;
+		Array<unsigned> slots;
+		parts.Resize(taskCount);
+		filled.Resize(taskCount, 0);
+		slots.Resize(taskCount, 0);
+
+		auto queue = [&](size_t i)
+		{
+			const ReadTask& task = tasks.Data()[i];
+			std::byte* target = readTarget(task, bounce.Data() + chunkBytes * slots[i], bDirect);
+			parts[i] = iovec{ target + filled[i], task.Length - filled[i] };
+			ring->QueueRead(fd, &parts[i], task.FileOffset + filled[i], i);
+		};
+
+		size_t nextTask = 0;
+		size_t completed = 0;
+		unsigned inFlight = 0;
+		bool bUnsupported = false;
+		bool bSubmitted = false;
+		std::exception_ptr error;
+
+		while (inFlight > 0 || (!error && !bUnsupported && completed < taskCount))
+		{
+			while (!error && !bUnsupported && inFlight < depth && nextTask < taskCount)
+			{
+				slots[nextTask] = freeSlots[freeSlots.Count() - 1];
+				freeSlots.RemoveAt(freeSlots.Count() - 1);
+				queue(nextTask++);
+				++inFlight;
+			}
+
+			try
+			{
+				if (error || bUnsupported)
+				{
+					ring->Wait(1);
+				}
+				else
+				{
+					ring->SubmitAndWait(1);
+					bSubmitted = true;
+				}
+			}
+			catch (const std::system_error&)
+			{
+				// Before the first successful submission the kernel holds none of our buffers,
+				// so a refused ring (e.g. blocked by a seccomp policy) can simply fall back.
+				if (!bSubmitted)
+				{
+					return false;
+				}
+
+				// Reads the kernel already took still target our buffers, so keep reaping them.
+				// If waiting itself keeps failing, back off and poll the completion ring.
+				if (!error)
+				{
+					error = std::current_exception();
+				}
+				inFlight -= ring->DiscardUnsubmitted();
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			ring->ForEachCompletion([&](uint64_t userData, int result)
+			{
+				size_t i = static_cast<size_t>(userData);
+				--inFlight;
+
+				if (result == -EAGAIN || result == -EINTR)
+				{
+					requeue.Add(i);
+					return;
+				}
+				if (result == -EINVAL && completed == 0 && !error)
+				{
+					bUnsupported = true;
+				}
+				else if (result < 0 && !error)
+				{
+					error = std::make_exception_ptr(std::system_error(-result, std::generic_category(), "ArrayLoader read failed"));
+				}
+				else if (result == 0 && filled[i] < requiredBytes(tasks.Data()[i]) && !error)
+				{
+					error = std::make_exception_ptr(std::runtime_error("ArrayFile is truncated"));
+				}
+				if (result <= 0)
+				{
+					freeSlots.Add(slots[i]);
+					return;
+				}
+
+				filled[i] += static_cast<size_t>(result);
+				if (filled[i] < requiredBytes(tasks.Data()[i]))
+				{
+					requeue.Add(i);
+					return;
+				}
+
+				finishRead(tasks.Data()[i], bounce.Data() + chunkBytes * slots[i], bDirect);
+				freeSlots.Add(slots[i]);
+				++completed;
+			});
+
+			for (size_t i : requeue)
+			{
+				if (error || bUnsupported)
+				{
+					freeSlots.Add(slots[i]);
+					continue;
+				}
+				queue(i);
+				++inFlight;
+			}
+			requeue.Clear();
+		}
+
+		if (bUnsupported)
+		{
+			return false;
+		}
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+		return true;
+	}
+#endif
+};
+
+} // namespace abouttt
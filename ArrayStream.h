@@ -0,0 +1,401 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+#include <unistd.h>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+// Streams raw element bytes to a file descriptor in fixed-size chunks. Add and Append fill one
+// chunk while a background thread writes the previous one, so production overlaps I/O and
+// memory stays at two chunks however many elements pass through. The stream has no header;
+// ArrayStreamReader reads it back.
+template <typename T>
+class ArrayStreamWriter
+{
+	static_assert(std::is_trivially_copyable_v<T>, "ArrayStreamWriter writes raw element bytes");
+
+public:
+	static constexpr size_t DEFAULT_CHUNK_BYTES = 4 * 1024 * 1024;
+
+public:
+	explicit ArrayStreamWriter(int fd, size_t chunkCount = std::max<size_t>(1, DEFAULT_CHUNK_BYTES / sizeof(T)))
+		: mFd(fd)
+		, mChunkCount(std::max<size_t>(1, chunkCount))
+		, mActive(mChunkCount)
+		, mPending(mChunkCount)
+		, mCount(0)
+		, mbPendingFull(false)
+		, mbStopping(false)
+		, mError()
+		, mMutex()
+		, mCondition()
+		, mWorker([this]() { run(); })
+	{
+	}
+
+	ArrayStreamWriter(const ArrayStreamWriter&) = delete;
+	ArrayStreamWriter& operator=(const ArrayStreamWriter&) = delete;
+
+	// Finishes the stream if Finish() was not called; write errors are lost here.
+	~ArrayStreamWriter()
+	{
+		try
+		{
+			Finish();
+		}
+		catch (...)
+		{
+		}
+	}
+
+public:
+	// A chunk is only left full when its submit failed, so the checks before buffering rethrow
+	// the writer's error rather than growing the chunk past mChunkCount.
+	void Add(const T& value)
+	{
+		if (mActive.Count() >= mChunkCount)
+		{
+			submit();
+		}
+
+		mActive.Add(value);
+		++mCount;
+		if (mActive.Count() >= mChunkCount)
+		{
+			submit();
+		}
+	}
+
+	void Append(const T* ptr, size_t count)
+	{
+		while (count > 0)
+		{
+			if (mActive.Count() >= mChunkCount)
+			{
+				submit();
+			}
+
+			size_t taken = std::min(count, mChunkCount - mActive.Count());
+			mActive.Append(ptr, taken);
+			mCount += taken;
+			ptr += taken;
+			count -= taken;
+			if (mActive.Count() >= mChunkCount)
+			{
+				submit();
+			}
+		}
+	}
+
+	void Append(std::span<const T> values)
+	{
+		Append(values.data(), values.size());
+	}
+
+	size_t ChunkCount() const noexcept
+	{
+		return mChunkCount;
+	}
+
+	// Elements accepted so far, including those not yet written.
+	size_t Count() const noexcept
+	{
+		return mCount;
+	}
+
+	// Writes the partial chunk, waits for the writer thread and rethrows any write error.
+	// Further calls rethrow the same error, or do nothing after a clean finish.
+	void Finish()
+	{
+		if (mWorker.joinable())
+		{
+			if (!mActive.IsEmpty())
+			{
+				try
+				{
+					submit();
+				}
+				catch (...)
+				{
+					stop();
+					throw;
+				}
+			}
+			stop();
+		}
+
+		// The writer thread has exited, so mError is no longer shared.
+		if (mError)
+		{
+			std::rethrow_exception(mError);
+		}
+	}
+
+private:
+	// Hands the full active chunk to the writer thread, first waiting for the previous one.
+	// A write error is kept, so this and every later call rethrows it.
+	void submit()
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mCondition.wait(lock, [this]() { return !mbPendingFull; });
+		if (mError)
+		{
+			std::rethrow_exception(mError);
+		}
+
+		mActive.Swap(mPending);
+		mbPendingFull = true;
+		lock.unlock();
+
+		mCondition.notify_all();
+		mActive.Clear();
+	}
+
+	void stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mbStopping = true;
+		}
+		mCondition.notify_all();
+		mWorker.join();
+	}
+
+	void run()
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		while (true)
+		{
+			mCondition.wait(lock, [this]() { return mbPendingFull || mbStopping; });
+			if (!mbPendingFull)
+			{
+				return;
+			}
+
+			// mPending belongs to this thread until mbPendingFull is cleared.
+			lock.unlock();
+			std::exception_ptr error;
+			try
+			{
+				writeAll(mPending.Data(), sizeof(T) * mPending.Count());
+			}
+			catch (...)
+			{
+				error = std::current_exception();
+			}
+			lock.lock();
+
+			if (error && !mError)
+			{
+				mError = error;
+			}
+			mbPendingFull = false;
+			mCondition.notify_all();
+		}
+	}
+
+	void writeAll(const T* data, size_t size)
+	{
+		const unsigned char* cursor = reinterpret_cast<const unsigned char*>(data);
+		while (size > 0)
+		{
+			ssize_t result = ::write(mFd, cursor, size);
+			if (result < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (result < 0)
+			{
+				throw std::system_error(errno, std::generic_category(), "ArrayStreamWriter write failed");
+			}
+			cursor += result;
+			size -= static_cast<size_t>(result);
+		}
+	}
+
+private:
+	int mFd;
+	size_t mChunkCount;
+	Array<T> mActive;
+	Array<T> mPending;
+	size_t mCount;
+	bool mbPendingFull;
+	bool mbStopping;
+	std::exception_ptr mError;
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	std::thread mWorker;
+};
+
+// Reads a raw element stream chunk by chunk. A background thread reads the next chunk while
+// the caller processes the current one, so memory stays at two chunks.
+template <typename T>
+class ArrayStreamReader
+{
+	static_assert(std::is_trivially_copyable_v<T>, "ArrayStreamReader reads raw element bytes");
+
+public:
+	static constexpr size_t DEFAULT_CHUNK_BYTES = ArrayStreamWriter<T>::DEFAULT_CHUNK_BYTES;
+
+public:
+	explicit ArrayStreamReader(int fd, size_t chunkCount = std::max<size_t>(1, DEFAULT_CHUNK_BYTES / sizeof(T)))
+		: mFd(fd)
+		, mChunkCount(std::max<size_t>(1, chunkCount))
+		, mCurrent(mChunkCount)
+		, mNext(mChunkCount)
+		, mbNextReady(false)
+		, mbEndOfStream(false)
+		, mbStopping(false)
+		, mError()
+		, mMutex()
+		, mCondition()
+		, mWorker([this]() { run(); })
+	{
+	}
+
+	ArrayStreamReader(const ArrayStreamReader&) = delete;
+	ArrayStreamReader& operator=(const ArrayStreamReader&) = delete;
+
+	~ArrayStreamReader()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mbStopping = true;
+		}
+		mCondition.notify_all();
+		mWorker.join();
+	}
+
+public:
+	size_t ChunkCount() const noexcept
+	{
+		return mChunkCount;
+	}
+
+	// Returns the next chunk, which stays valid until the following call. Only the last chunk
+	// may be short, and an empty span marks the end of the stream. Read errors, including a
+	// stream that ends partway through an element, are rethrown here.
+	std::span<const T> Next()
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mCondition.wait(lock, [this]() { return mbNextReady; });
+		if (mError)
+		{
+			std::rethrow_exception(mError);
+		}
+
+		mCurrent.Swap(mNext);
+		if (!mbEndOfStream)
+		{
+			mbNextReady = false;
+			lock.unlock();
+			mCondition.notify_all();
+		}
+		else
+		{
+			mNext.Clear();
+		}
+		return std::span<const T>(mCurrent.Data(), mCurrent.Count());
+	}
+
+private:
+	void run()
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		while (true)
+		{
+			mCondition.wait(lock, [this]() { return !mbNextReady || mbStopping; });
+			if (mbStopping)
+			{
+				return;
+			}
+
+			// mNext belongs to this thread until mbNextReady is set.
+			lock.unlock();
+			std::exception_ptr error;
+			bool bEnd = false;
+			try
+			{
+				bEnd = readChunk();
+			}
+			catch (...)
+			{
+				error = std::current_exception();
+				bEnd = true;
+			}
+			lock.lock();
+
+			mError = error;
+			mbEndOfStream = bEnd;
+			mbNextReady = true;
+			mCondition.notify_all();
+			if (bEnd)
+			{
+				return;
+			}
+		}
+	}
+
+	// Fills mNext with up to a chunk of elements and reports whether the stream ended.
+	bool readChunk()
+	{
+		mNext.ResizeUninitialized(mChunkCount);
+		unsigned char* cursor = reinterpret_cast<unsigned char*>(mNext.Data());
+		size_t wanted = sizeof(T) * mChunkCount;
+		size_t filled = 0;
+
+		while (filled < wanted)
+		{
+			ssize_t result = ::read(mFd, cursor + filled, wanted - filled);
+			if (result < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (result < 0)
+			{
+				throw std::system_error(errno, std::generic_category(), "ArrayStreamReader read failed");
+			}
+			if (result == 0)
+			{
+				break;
+			}
+			filled += static_cast<size_t>(result);
+		}
+
+		if (filled % sizeof(T) != 0)
+		{
+			throw std::runtime_error("ArrayStreamReader stream ends inside an element");
+		}
+		mNext.ResizeUninitialized(filled / sizeof(T));
+		return filled < wanted;
+	}
+
+private:
+	int mFd;
+	size_t mChunkCount;
+	Array<T> mCurrent;
+	Array<T> mNext;
+	bool mbNextReady;
+	bool mbEndOfStream;
+	bool mbStopping;
+	std::exception_ptr mError;
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	std::thread mWorker;
+};
+
+} // namespace abouttt
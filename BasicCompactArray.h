@@ -0,0 +1,415 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+// Array surface shared by CompactArray and ThinArray, which differ only in where the 32-bit
+// count and capacity live. Storage owns the block and the element lifetimes and provides:
+//   NAME                     class name used in exception messages
+//   Data(), Count(), Capacity()
+//   SetCount(count)          only called when Capacity() > 0
+//   Reallocate(capacity)     moves the elements into a block of exactly capacity >= Count()
+//                            elements; 0 releases the block
+//   Release()                destroys the elements and frees the block
+//   Swap(other)
+// Capacity never exceeds MAX_COUNT; growing past it throws std::length_error.
+template <typename T, typename Storage>
+class BasicCompactArray
+{
+public:
+	using Iterator = ArrayIterator<T>;
+	using ConstIterator = ArrayIterator<const T>;
+	using ReverseIterator = std::reverse_iterator<Iterator>;
+	using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+public:
+	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
+	static constexpr size_t MAX_COUNT = std::numeric_limits<uint32_t>::max();
+
+public:
+	BasicCompactArray() noexcept
+		: mStorage()
+	{
+	}
+
+	explicit BasicCompactArray(size_t capacity)
+		: BasicCompactArray()
+	{
+		Reserve(capacity);
+	}
+
+	BasicCompactArray(std::initializer_list<T> ilist)
+		: BasicCompactArray(ilist.size())
+	{
+		Append(ilist.begin(), ilist.size());
+	}
+
+	BasicCompactArray(const BasicCompactArray& other)
+		: BasicCompactArray(other.Count())
+	{
+		Append(other.Data(), other.Count());
+	}
+
+	BasicCompactArray(BasicCompactArray&& other) noexcept
+		: mStorage(std::move(other.mStorage))
+	{
+	}
+
+	~BasicCompactArray()
+	{
+		mStorage.Release();
+	}
+
+public:
+	BasicCompactArray& operator=(const BasicCompactArray& other)
+	{
+		if (this != &other)
+		{
+			BasicCompactArray temp(other);
+			Swap(temp);
+		}
+		return *this;
+	}
+
+	BasicCompactArray& operator=(BasicCompactArray&& other) noexcept
+	{
+		if (this != &other)
+		{
+			mStorage.Release();
+			mStorage.Swap(other.mStorage);
+		}
+		return *this;
+	}
+
+	T& operator[](size_t index)
+	{
+		checkRange(index);
+		return Data()[index];
+	}
+
+	const T& operator[](size_t index) const
+	{
+		checkRange(index);
+		return Data()[index];
+	}
+
+	auto operator<=>(const BasicCompactArray& other) const
+	{
+		return std::lexicographical_compare_three_way(
+			Data(), Data() + Count(),
+			other.Data(), other.Data() + other.Count()
+		);
+	}
+
+	bool operator==(const BasicCompactArray& other) const
+	{
+		return Count() == other.Count() && std::equal(Data(), Data() + Count(), other.Data());
+	}
+
+public:
+	void Add(const T& value)
+	{
+		Emplace(value);
+	}
+
+	void Add(T&& value)
+	{
+		Emplace(std::move(value));
+	}
+
+	void Append(const T* ptr, size_t count)
+	{
+		Insert(Count(), ptr, count);
+	}
+
+	size_t Capacity() const noexcept
+	{
+		return mStorage.Capacity();
+	}
+
+	void Clear() noexcept
+	{
+		if (Capacity() > 0)
+		{
+			std::destroy_n(Data(), Count());
+			mStorage.SetCount(0);
+		}
+	}
+
+	bool Contains(const T& value) const
+	{
+		return Find(value) != INDEX_NONE;
+	}
+
+	template <typename Predicate>
+	bool ContainsIf(Predicate pred) const
+	{
+		return FindIf(pred) != INDEX_NONE;
+	}
+
+	size_t Count() const noexcept
+	{
+		return mStorage.Count();
+	}
+
+	T* Data() noexcept
+	{
+		return mStorage.Data();
+	}
+
+	const T* Data() const noexcept
+	{
+		return mStorage.Data();
+	}
+
+	template <typename... Args>
+	T& Emplace(Args&&... args)
+	{
+		size_t index = EmplaceAt(Count(), std::forward<Args>(args)...);
+		return Data()[index];
+	}
+
+	template <typename... Args>
+	size_t EmplaceAt(size_t index, Args&&... args)
+	{
+		checkRange(index, true);
+		ensureCapacity(Count() + 1);
+
+		T* data = Data();
+		size_t count = Count();
+		if (index < count)
+		{
+			std::uninitialized_move_n(data + count - 1, 1, data + count);
+			std::move_backward(data + index, data + count - 1, data + count);
+			std::destroy_at(data + index);
+		}
+		std::construct_at(data + index, std::forward<Args>(args)...);
+		mStorage.SetCount(count + 1);
+
+		return index;
+	}
+
+	size_t Find(const T& value) const
+	{
+		const T* data = Data();
+		const T* it = std::find(data, data + Count(), value);
+		return it != data + Count() ? static_cast<size_t>(it - data) : INDEX_NONE;
+	}
+
+	template <typename Predicate>
+	size_t FindIf(Predicate pred) const
+	{
+		const T* data = Data();
+		const T* it = std::find_if(data, data + Count(), pred);
+		return it != data + Count() ? static_cast<size_t>(it - data) : INDEX_NONE;
+	}
+
+	size_t Insert(size_t index, const T& value)
+	{
+		return EmplaceAt(index, value);
+	}
+
+	size_t Insert(size_t index, T&& value)
+	{
+		return EmplaceAt(index, std::move(value));
+	}
+
+	size_t Insert(size_t index, const T* ptr, size_t count)
+	{
+		checkRange(index, true);
+
+		if (count == 0)
+		{
+			return index;
+		}
+
+		ensureCapacity(Count() + count);
+
+		T* data = Data();
+		size_t oldCount = Count();
+		size_t moved = std::min(oldCount - index, count);
+		std::uninitialized_move_n(data + oldCount - moved, moved, data + oldCount + count - moved);
+		std::move_backward(data + index, data + oldCount - moved, data + oldCount + count - moved);
+		std::destroy_n(data + index, moved);
+		std::uninitialized_copy_n(ptr, count, data + index);
+		mStorage.SetCount(oldCount + count);
+
+		return index;
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return Count() == 0;
+	}
+
+	bool Remove(const T& value)
+	{
+		size_t index = Find(value);
+		if (index != INDEX_NONE)
+		{
+			RemoveAt(index);
+			return true;
+		}
+		return false;
+	}
+
+	template <typename Predicate>
+	size_t RemoveAll(Predicate pred)
+	{
+		T* data = Data();
+		size_t count = Count();
+		T* newEnd = std::remove_if(data, data + count, pred);
+		size_t removedCount = static_cast<size_t>((data + count) - newEnd);
+		std::destroy(newEnd, data + count);
+		if (removedCount > 0)
+		{
+			mStorage.SetCount(count - removedCount);
+		}
+		return removedCount;
+	}
+
+	void RemoveAt(size_t index)
+	{
+		checkRange(index);
+		T* data = Data();
+		size_t count = Count();
+		std::move(data + index + 1, data + count, data + index);
+		std::destroy_at(data + count - 1);
+		mStorage.SetCount(count - 1);
+	}
+
+	void Reserve(size_t newCapacity)
+	{
+		if (newCapacity > Capacity())
+		{
+			reallocate(newCapacity);
+		}
+	}
+
+	void Resize(size_t newCount, const T& value = T())
+	{
+		size_t count = Count();
+		if (newCount > count)
+		{
+			ensureCapacity(newCount);
+			std::uninitialized_fill_n(Data() + count, newCount - count, value);
+		}
+		else
+		{
+			std::destroy_n(Data() + newCount, count - newCount);
+		}
+		if (Capacity() > 0)
+		{
+			mStorage.SetCount(newCount);
+		}
+	}
+
+	// An empty array releases its block entirely, returning to the allocation-free state.
+	void Shrink()
+	{
+		if (Capacity() > Count())
+		{
+			reallocate(Count());
+		}
+	}
+
+	template <typename Compare>
+	void Sort(Compare comp)
+	{
+		std::sort(Data(), Data() + Count(), comp);
+	}
+
+	void Swap(BasicCompactArray& other) noexcept
+	{
+		mStorage.Swap(other.mStorage);
+	}
+
+public: // Iterators for range-based loop support.
+	Iterator begin() noexcept
+	{
+		return Iterator(Data());
+	}
+
+	ConstIterator begin() const noexcept
+	{
+		return ConstIterator(Data());
+	}
+
+	Iterator end() noexcept
+	{
+		return Iterator(Data() + Count());
+	}
+
+	ConstIterator end() const noexcept
+	{
+		return ConstIterator(Data() + Count());
+	}
+
+	ReverseIterator rbegin() noexcept
+	{
+		return ReverseIterator(end());
+	}
+
+	ConstReverseIterator rbegin() const noexcept
+	{
+		return ConstReverseIterator(end());
+	}
+
+	ReverseIterator rend() noexcept
+	{
+		return ReverseIterator(begin());
+	}
+
+	ConstReverseIterator rend() const noexcept
+	{
+		return ConstReverseIterator(begin());
+	}
+
+private:
+	void checkRange(size_t index, bool bAllowEnd = false) const
+	{
+		if (index >= Count() + (bAllowEnd ? 1 : 0))
+		{
+			throw std::out_of_range(std::string(Storage::NAME) + " index out of range");
+		}
+	}
+
+	void ensureCapacity(size_t minCapacity)
+	{
+		size_t capacity = Capacity();
+		if (minCapacity > capacity)
+		{
+			size_t grow = capacity + (capacity >> 1); // Grow by 1.5x
+			size_t newCapacity = std::max(minCapacity, capacity == 0 ? 8 : grow);
+			reallocate(std::max(minCapacity, std::min(newCapacity, MAX_COUNT)));
+		}
+	}
+
+	void reallocate(size_t newCapacity)
+	{
+		if (newCapacity > MAX_COUNT)
+		{
+			throw std::length_error(std::string(Storage::NAME) + " capacity exceeded");
+		}
+		mStorage.Reallocate(newCapacity);
+	}
+
+private:
+	Storage mStorage;
+};
+
+} // namespace abouttt
@@ -0,0 +1,307 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+class BitArray
+{
+public:
+	using Word = uint64_t;
+
+public:
+	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
+	static constexpr size_t WORD_BITS = 64;
+
+public:
+	BitArray() noexcept
+		: mWords()
+		, mCount(0)
+	{
+	}
+
+	explicit BitArray(size_t count, bool value = false)
+		: BitArray()
+	{
+		Resize(count, value);
+	}
+
+public:
+	bool operator[](size_t index) const
+	{
+		return Get(index);
+	}
+
+	bool operator==(const BitArray& other) const
+	{
+		return mCount == other.mCount && mWords == other.mWords;
+	}
+
+	BitArray& operator&=(const BitArray& other)
+	{
+		And(other);
+		return *this;
+	}
+
+	BitArray& operator|=(const BitArray& other)
+	{
+		Or(other);
+		return *this;
+	}
+
+	BitArray& operator^=(const BitArray& other)
+	{
+		Xor(other);
+		return *this;
+	}
+
+public:
+	void Add(bool value)
+	{
+		if (mCount % WORD_BITS == 0)
+		{
+			mWords.Add(0);
+		}
+		++mCount;
+		Set(mCount - 1, value);
+	}
+
+	void And(const BitArray& other)
+	{
+		checkSameCount(other);
+		Word* lhs = mWords.Data();
+		const Word* rhs = other.mWords.Data();
+		for (size_t i = 0, n = mWords.Count(); i < n; ++i)
+		{
+			lhs[i] &= rhs[i];
+		}
+	}
+
+	void AndNot(const BitArray& other)
+	{
+		checkSameCount(other);
+		Word* lhs = mWords.Data();
+		const Word* rhs = other.mWords.Data();
+		for (size_t i = 0, n = mWords.Count(); i < n; ++i)
+		{
+			lhs[i] &= ~rhs[i];
+		}
+	}
+
+	size_t Capacity() const noexcept
+	{
+		return mWords.Capacity() * WORD_BITS;
+	}
+
+	void Clear() noexcept
+	{
+		mWords.Clear();
+		mCount = 0;
+	}
+
+	size_t Count() const noexcept
+	{
+		return mCount;
+	}
+
+	size_t CountSet() const noexcept
+	{
+		const Word* words = mWords.Data();
+		size_t result = 0;
+		for (size_t i = 0, n = mWords.Count(); i < n; ++i)
+		{
+			result += static_cast<size_t>(std::popcount(words[i]));
+		}
+		return result;
+	}
+
+	size_t FindFirstSet() const noexcept
+	{
+		return findSetFrom(0);
+	}
+
+	// Searches after index. A start at or past the end, including INDEX_NONE, finds nothing
+	// rather than wrapping around to 0.
+	size_t FindNextSet(size_t index) const noexcept
+	{
+		return index >= mCount || index + 1 >= mCount ? INDEX_NONE : findSetFrom(index + 1);
+	}
+
+	void Flip(size_t index)
+	{
+		checkRange(index);
+		mWords.Data()[index / WORD_BITS] ^= bitMask(index);
+	}
+
+	template <typename Function>
+	void ForEachSetBit(Function func) const
+	{
+		const Word* words = mWords.Data();
+		for (size_t i = 0, n = mWords.Count(); i < n; ++i)
+		{
+			for (Word word = words[i]; word != 0; word &= word - 1)
+			{
+				func(i * WORD_BITS + static_cast<size_t>(std::countr_zero(word)));
+			}
+		}
+	}
+
+	bool Get(size_t index) const
+	{
+		checkRange(index);
+		return (mWords.Data()[index / WORD_BITS] & bitMask(index)) != 0;
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return mCount == 0;
+	}
+
+	void Or(const BitArray& other)
+	{
+		checkSameCount(other);
+		Word* lhs = mWords.Data();
+		const Word* rhs = other.mWords.Data();
+		for (size_t i = 0, n = mWords.Count(); i < n; ++i)
+		{
+			lhs[i] |= rhs[i];
+		}
+	}
+
+	void Reserve(size_t newCapacity)
+	{
+		mWords.Reserve(wordsFor(newCapacity));
+	}
+
+	void Resize(size_t newCount, bool value = false)
+	{
+		if (newCount > mCount && value)
+		{
+			size_t tail = mCount % WORD_BITS;
+			if (tail != 0)
+			{
+				mWords.Data()[mWords.Count() - 1] |= ~Word(0) << tail;
+			}
+		}
+		mWords.Resize(wordsFor(newCount), value ? ~Word(0) : Word(0));
+		mCount = newCount;
+		trimTail();
+	}
+
+	void Set(size_t index, bool value = true)
+	{
+		checkRange(index);
+		Word& word = mWords.Data()[index / WORD_BITS];
+		word = value ? (word | bitMask(index)) : (word & ~bitMask(index));
+	}
+
+	void SetAll(bool value)
+	{
+		std::fill(mWords.begin(), mWords.end(), value ? ~Word(0) : Word(0));
+		trimTail();
+	}
+
+	void Shrink()
+	{
+		mWords.Shrink();
+	}
+
+	void Swap(BitArray& other) noexcept
+	{
+		mWords.Swap(other.mWords);
+		std::swap(mCount, other.mCount);
+	}
+
+	std::span<const Word> Words() const noexcept
+	{
+		return std::span<const Word>(mWords.Data(), mWords.Count());
+	}
+
+	void Xor(const BitArray& other)
+	{
+		checkSameCount(other);
+		Word* lhs = mWords.Data();
+		const Word* rhs = other.mWords.Data();
+		for (size_t i = 0, n = mWords.Count(); i < n; ++i)
+		{
+			lhs[i] ^= rhs[i];
+		}
+	}
+
+private:
+	static constexpr size_t wordsFor(size_t count) noexcept
+	{
+		return (count + WORD_BITS - 1) / WORD_BITS;
+	}
+
+	static constexpr Word bitMask(size_t index) noexcept
+	{
+		return Word(1) << (index % WORD_BITS);
+	}
+
+	size_t findSetFrom(size_t index) const noexcept
+	{
+		if (index >= mCount)
+		{
+			return INDEX_NONE;
+		}
+
+		const Word* words = mWords.Data();
+		size_t wordIndex = index / WORD_BITS;
+		Word word = words[wordIndex] & (~Word(0) << (index % WORD_BITS));
+
+		for (size_t n = mWords.Count(); ; )
+		{
+			if (word != 0)
+			{
+				return wordIndex * WORD_BITS + static_cast<size_t>(std::countr_zero(word));
+			}
+			if (++wordIndex == n)
+			{
+				return INDEX_NONE;
+			}
+			word = words[wordIndex];
+		}
+	}
+
+	// Bits past mCount in the last word are kept clear so word-level operations need no masking.
+	void trimTail() noexcept
+	{
+		size_t tail = mCount % WORD_BITS;
+		if (tail != 0)
+		{
+			mWords.Data()[mWords.Count() - 1] &= (Word(1) << tail) - 1;
+		}
+	}
+
+	void checkRange(size_t index) const
+	{
+		if (index >= mCount)
+		{
+			throw std::out_of_range("BitArray index out of range");
+		}
+	}
+
+	void checkSameCount(const BitArray& other) const
+	{
+		if (mCount != other.mCount)
+		{
+			throw std::invalid_argument("BitArray operands differ in count");
+		}
+	}
+
+private:
+	Array<Word> mWords;
+	size_t mCount;
+};
+
+} // namespace abouttt
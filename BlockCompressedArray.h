@@ -0,0 +1,312 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+class BlockCompressedArray
+{
+public:
+	using Word = uint64_t;
+
+public:
+	static constexpr size_t BLOCK_SIZE = 128;
+	static constexpr size_t ANCHOR_STRIDE = 16;
+	static constexpr size_t WORD_BITS = 64;
+
+public:
+	BlockCompressedArray() noexcept
+		: mBlocks()
+		, mWords()
+		, mCount(0)
+	{
+	}
+
+	explicit BlockCompressedArray(const Array<uint64_t>& source)
+		: BlockCompressedArray()
+	{
+		mBlocks.Reserve((source.Count() + BLOCK_SIZE - 1) / BLOCK_SIZE);
+		for (size_t first = 0; first < source.Count(); first += BLOCK_SIZE)
+		{
+			encodeBlock(source.Data() + first, std::min(BLOCK_SIZE, source.Count() - first));
+		}
+		mCount = source.Count();
+		mWords.Shrink();
+	}
+
+public:
+	uint64_t operator[](size_t index) const
+	{
+		return Get(index);
+	}
+
+public:
+	size_t BlockCount() const noexcept
+	{
+		return mBlocks.Count();
+	}
+
+	size_t CompressedBytes() const noexcept
+	{
+		return mBlocks.Count() * sizeof(BlockHeader) + mWords.Count() * sizeof(Word);
+	}
+
+	size_t Count() const noexcept
+	{
+		return mCount;
+	}
+
+	// Writes up to BLOCK_SIZE values of the given block to out and returns how many were written.
+	size_t DecodeBlock(size_t blockIndex, uint64_t* out) const
+	{
+		checkBlockRange(blockIndex);
+
+		const BlockHeader& header = mBlocks[blockIndex];
+		size_t count = blockCount(blockIndex);
+		unpack(mWords.Data() + header.WordOffset, header.BitWidth, count, out);
+
+		if (header.bDelta)
+		{
+			uint64_t running = header.Base;
+			for (size_t i = 0; i < count; ++i)
+			{
+				running += out[i];
+				out[i] = running;
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				out[i] += header.Base;
+			}
+		}
+		return count;
+	}
+
+	void Decompress(Array<uint64_t>& target) const
+	{
+		target.Resize(mCount);
+		for (size_t b = 0; b < mBlocks.Count(); ++b)
+		{
+			DecodeBlock(b, target.Data() + b * BLOCK_SIZE);
+		}
+	}
+
+	template <typename Function>
+	void ForEach(Function func) const
+	{
+		uint64_t buffer[BLOCK_SIZE];
+		for (size_t b = 0; b < mBlocks.Count(); ++b)
+		{
+			size_t count = DecodeBlock(b, buffer);
+			for (size_t i = 0; i < count; ++i)
+			{
+				func(buffer[i]);
+			}
+		}
+	}
+
+	// Frame-of-reference blocks decode a single value. Delta blocks start from the nearest
+	// anchor at or before the index and sum at most ANCHOR_STRIDE - 1 deltas after it. For
+	// whole-array scans, ForEach or DecodeBlock is still cheaper per value.
+	uint64_t Get(size_t index) const
+	{
+		checkRange(index);
+
+		size_t blockIndex = index / BLOCK_SIZE;
+		const BlockHeader& header = mBlocks[blockIndex];
+		const Word* words = mWords.Data() + header.WordOffset;
+		size_t offset = index % BLOCK_SIZE;
+
+		if (!header.bDelta)
+		{
+			return header.Base + unpackOne(words, header.BitWidth, offset);
+		}
+
+		size_t anchor = offset / ANCHOR_STRIDE;
+		uint64_t value = header.Base;
+		if (anchor > 0)
+		{
+			const Word* anchors = words + wordsFor(blockCount(blockIndex), header.BitWidth);
+			value += unpackOne(anchors, header.AnchorWidth, anchor - 1);
+		}
+		for (size_t i = anchor * ANCHOR_STRIDE + 1; i <= offset; ++i)
+		{
+			value += unpackOne(words, header.BitWidth, i);
+		}
+		return value;
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return mCount == 0;
+	}
+
+	void Swap(BlockCompressedArray& other) noexcept
+	{
+		mBlocks.Swap(other.mBlocks);
+		mWords.Swap(other.mWords);
+		std::swap(mCount, other.mCount);
+	}
+
+private:
+	struct BlockHeader
+	{
+		uint64_t Base;
+		size_t WordOffset;
+		uint8_t BitWidth;
+		uint8_t AnchorWidth;
+		bool bDelta;
+	};
+
+	void encodeBlock(const uint64_t* values, size_t count)
+	{
+		bool bSorted = std::is_sorted(values, values + count);
+		uint64_t residuals[BLOCK_SIZE];
+		uint64_t base;
+
+		if (bSorted)
+		{
+			base = values[0];
+			residuals[0] = 0;
+			for (size_t i = 1; i < count; ++i)
+			{
+				residuals[i] = values[i] - values[i - 1];
+			}
+		}
+		else
+		{
+			base = *std::min_element(values, values + count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				residuals[i] = values[i] - base;
+			}
+		}
+
+		uint64_t bits = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			bits |= residuals[i];
+		}
+		uint8_t bitWidth = static_cast<uint8_t>(std::bit_width(bits));
+
+		// Delta blocks also store the offset from Base of every ANCHOR_STRIDE-th value after the
+		// first, packed after the deltas, so Get never sums more than a stride of deltas.
+		uint64_t anchors[BLOCK_SIZE / ANCHOR_STRIDE];
+		size_t anchorCount = bSorted ? (count - 1) / ANCHOR_STRIDE : 0;
+		for (size_t k = 0; k < anchorCount; ++k)
+		{
+			anchors[k] = values[(k + 1) * ANCHOR_STRIDE] - base;
+		}
+		uint8_t anchorWidth = anchorCount > 0 ? static_cast<uint8_t>(std::bit_width(values[count - 1] - base)) : 0;
+
+		size_t wordOffset = mWords.Count();
+		size_t residualWords = wordsFor(count, bitWidth);
+		mWords.Resize(wordOffset + residualWords + wordsFor(anchorCount, anchorWidth), 0);
+		pack(residuals, count, bitWidth, mWords.Data() + wordOffset);
+		pack(anchors, anchorCount, anchorWidth, mWords.Data() + wordOffset + residualWords);
+
+		mBlocks.Add(BlockHeader{ base, wordOffset, bitWidth, anchorWidth, bSorted });
+	}
+
+	static constexpr size_t wordsFor(size_t count, size_t bitWidth) noexcept
+	{
+		return (count * bitWidth + WORD_BITS - 1) / WORD_BITS;
+	}
+
+	static void pack(const uint64_t* values, size_t count, size_t bitWidth, Word* words) noexcept
+	{
+		if (bitWidth == 0)
+		{
+			return;
+		}
+
+		for (size_t i = 0, bit = 0; i < count; ++i, bit += bitWidth)
+		{
+			size_t wordIndex = bit / WORD_BITS;
+			size_t shift = bit % WORD_BITS;
+			words[wordIndex] |= values[i] << shift;
+			if (shift + bitWidth > WORD_BITS)
+			{
+				words[wordIndex + 1] |= values[i] >> (WORD_BITS - shift);
+			}
+		}
+	}
+
+	static void unpack(const Word* words, size_t bitWidth, size_t count, uint64_t* out) noexcept
+	{
+		if (bitWidth == 0)
+		{
+			std::fill_n(out, count, 0);
+			return;
+		}
+
+		const Word mask = bitWidth == WORD_BITS ? ~Word(0) : (Word(1) << bitWidth) - 1;
+		for (size_t i = 0, bit = 0; i < count; ++i, bit += bitWidth)
+		{
+			size_t wordIndex = bit / WORD_BITS;
+			size_t shift = bit % WORD_BITS;
+			Word value = words[wordIndex] >> shift;
+			if (shift + bitWidth > WORD_BITS)
+			{
+				value |= words[wordIndex + 1] << (WORD_BITS - shift);
+			}
+			out[i] = value & mask;
+		}
+	}
+
+	static uint64_t unpackOne(const Word* words, size_t bitWidth, size_t index) noexcept
+	{
+		if (bitWidth == 0)
+		{
+			return 0;
+		}
+
+		const Word mask = bitWidth == WORD_BITS ? ~Word(0) : (Word(1) << bitWidth) - 1;
+		size_t bit = index * bitWidth;
+		size_t wordIndex = bit / WORD_BITS;
+		size_t shift = bit % WORD_BITS;
+		Word value = words[wordIndex] >> shift;
+		if (shift + bitWidth > WORD_BITS)
+		{
+			value |= words[wordIndex + 1] << (WORD_BITS - shift);
+		}
+		return value & mask;
+	}
+
+	size_t blockCount(size_t blockIndex) const noexcept
+	{
+		return std::min(BLOCK_SIZE, mCount - blockIndex * BLOCK_SIZE);
+	}
+
+	void checkRange(size_t index) const
+	{
+		if (index >= mCount)
+		{
+			throw std::out_of_range("BlockCompressedArray index out of range");
+		}
+	}
+
+	void checkBlockRange(size_t blockIndex) const
+	{
+		if (blockIndex >= mBlocks.Count())
+		{
+			throw std::out_of_range("BlockCompressedArray block index out of range");
+		}
+	}
+
+private:
+	Array<BlockHeader> mBlocks;
+	Array<Word> mWords;
+	size_t mCount;
+};
+
+} // namespace abouttt
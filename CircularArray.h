@@ -0,0 +1,573 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace abouttt
+{
+
+template <typename T>
+class CircularArrayIterator;
+
+template <typename T>
+class CircularArray
+{
+public:
+	using Iterator = CircularArrayIterator<T>;
+	using ConstIterator = CircularArrayIterator<const T>;
+	using ReverseIterator = std::reverse_iterator<Iterator>;
+	using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+public:
+	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
+
+public:
+	CircularArray() noexcept
+		: CircularArray(0)
+	{
+	}
+
+	// A bounded array never grows past capacity; pushing into a full one overwrites the
+	// element at the opposite end, which suits sliding windows.
+	explicit CircularArray(size_t capacity, bool bBounded = false)
+		: mData(nullptr)
+		, mHead(0)
+		, mCount(0)
+		, mCapacity(0)
+		, mLimit(bBounded ? capacity : 0)
+	{
+		if (bBounded && capacity == 0)
+		{
+			throw std::invalid_argument("Bounded CircularArray requires a capacity");
+		}
+		reallocate(capacity > 0 ? std::bit_ceil(capacity) : 0);
+	}
+
+	CircularArray(std::initializer_list<T> ilist)
+		: CircularArray(ilist.size())
+	{
+		std::uninitialized_copy(ilist.begin(), ilist.end(), mData);
+		mCount = ilist.size();
+	}
+
+	CircularArray(const CircularArray& other)
+		: CircularArray(other.mCapacity)
+	{
+		mLimit = other.mLimit;
+		for (const T& value : other)
+		{
+			std::construct_at(mData + mCount, value);
+			++mCount;
+		}
+	}
+
+	CircularArray(CircularArray&& other) noexcept
+		: mData(std::exchange(other.mData, nullptr))
+		, mHead(std::exchange(other.mHead, 0))
+		, mCount(std::exchange(other.mCount, 0))
+		, mCapacity(std::exchange(other.mCapacity, 0))
+		, mLimit(std::exchange(other.mLimit, 0))
+	{
+	}
+
+	~CircularArray()
+	{
+		cleanup();
+	}
+
+public:
+	CircularArray& operator=(const CircularArray& other)
+	{
+		if (this != &other)
+		{
+			CircularArray temp(other);
+			Swap(temp);
+		}
+		return *this;
+	}
+
+	CircularArray& operator=(CircularArray&& other) noexcept
+	{
+		if (this != &other)
+		{
+			cleanup();
+			mData = std::exchange(other.mData, nullptr);
+			mHead = std::exchange(other.mHead, 0);
+			mCount = std::exchange(other.mCount, 0);
+			mCapacity = std::exchange(other.mCapacity, 0);
+			mLimit = std::exchange(other.mLimit, 0);
+		}
+		return *this;
+	}
+
+	T& operator[](size_t index)
+	{
+		checkRange(index);
+		return mData[slot(index)];
+	}
+
+	const T& operator[](size_t index) const
+	{
+		checkRange(index);
+		return mData[slot(index)];
+	}
+
+public:
+	T& Back()
+	{
+		checkRange(0);
+		return mData[slot(mCount - 1)];
+	}
+
+	const T& Back() const
+	{
+		checkRange(0);
+		return mData[slot(mCount - 1)];
+	}
+
+	size_t Capacity() const noexcept
+	{
+		return mLimit != 0 ? mLimit : mCapacity;
+	}
+
+	void Clear() noexcept
+	{
+		for (size_t i = 0; i < mCount; ++i)
+		{
+			std::destroy_at(mData + slot(i));
+		}
+		mHead = 0;
+		mCount = 0;
+	}
+
+	bool Contains(const T& value) const
+	{
+		return Find(value) != INDEX_NONE;
+	}
+
+	size_t Count() const noexcept
+	{
+		return mCount;
+	}
+
+	template <typename... Args>
+	T& EmplaceBack(Args&&... args)
+	{
+		if (hasFreeSlot())
+		{
+			T* target = mData + slot(mCount);
+			std::construct_at(target, std::forward<Args>(args)...);
+			++mCount;
+			return *target;
+		}
+
+		// Evicting or growing would destroy or move an element args may refer to, such as
+		// PushBack(Front()), so the new element is built first.
+		T value(std::forward<Args>(args)...);
+		if (isAtLimit())
+		{
+			PopFront();
+		}
+
+		ensureCapacity(mCount + 1);
+		T* target = mData + slot(mCount);
+		std::construct_at(target, std::move(value));
+		++mCount;
+
+		return *target;
+	}
+
+	template <typename... Args>
+	T& EmplaceFront(Args&&... args)
+	{
+		if (hasFreeSlot())
+		{
+			size_t head = (mHead - 1) & (mCapacity - 1);
+			std::construct_at(mData + head, std::forward<Args>(args)...);
+			mHead = head;
+			++mCount;
+			return mData[mHead];
+		}
+
+		T value(std::forward<Args>(args)...);
+		if (isAtLimit())
+		{
+			PopBack();
+		}
+
+		ensureCapacity(mCount + 1);
+		size_t head = (mHead - 1) & (mCapacity - 1);
+		std::construct_at(mData + head, std::move(value));
+		mHead = head;
+		++mCount;
+
+		return mData[mHead];
+	}
+
+	size_t Find(const T& value) const
+	{
+		return FindIf([&value](const T& element) { return element == value; });
+	}
+
+	template <typename Predicate>
+	size_t FindIf(Predicate pred) const
+	{
+		for (size_t i = 0; i < mCount; ++i)
+		{
+			if (pred(mData[slot(i)]))
+			{
+				return i;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	T& Front()
+	{
+		checkRange(0);
+		return mData[mHead];
+	}
+
+	const T& Front() const
+	{
+		checkRange(0);
+		return mData[mHead];
+	}
+
+	bool IsBounded() const noexcept
+	{
+		return mLimit != 0;
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return mCount == 0;
+	}
+
+	bool IsFull() const noexcept
+	{
+		return mCount == Capacity();
+	}
+
+	// Moves the elements to the start of storage when they wrap around, so they can be
+	// handed to code that expects one contiguous range.
+	std::span<T> Linearize()
+	{
+		if (mHead + mCount > mCapacity)
+		{
+			reallocate(mCapacity);
+		}
+		return std::span<T>(mData + mHead, mCount);
+	}
+
+	void PopBack()
+	{
+		checkRange(0);
+		std::destroy_at(mData + slot(mCount - 1));
+		--mCount;
+	}
+
+	void PopFront()
+	{
+		checkRange(0);
+		std::destroy_at(mData + mHead);
+		mHead = (mHead + 1) & (mCapacity - 1);
+		--mCount;
+	}
+
+	void PushBack(const T& value)
+	{
+		EmplaceBack(value);
+	}
+
+	void PushBack(T&& value)
+	{
+		EmplaceBack(std::move(value));
+	}
+
+	void PushFront(const T& value)
+	{
+		EmplaceFront(value);
+	}
+
+	void PushFront(T&& value)
+	{
+		EmplaceFront(std::move(value));
+	}
+
+	void Reserve(size_t newCapacity)
+	{
+		if (mLimit == 0 && newCapacity > mCapacity)
+		{
+			reallocate(std::bit_ceil(newCapacity));
+		}
+	}
+
+	void Swap(CircularArray& other) noexcept
+	{
+		std::swap(mData, other.mData);
+		std::swap(mHead, other.mHead);
+		std::swap(mCount, other.mCount);
+		std::swap(mCapacity, other.mCapacity);
+		std::swap(mLimit, other.mLimit);
+	}
+
+public: // Iterators for range-based loop support.
+	Iterator begin() noexcept
+	{
+		return Iterator(mData, mCapacity - 1, mHead);
+	}
+
+	ConstIterator begin() const noexcept
+	{
+		return ConstIterator(mData, mCapacity - 1, mHead);
+	}
+
+	Iterator end() noexcept
+	{
+		return Iterator(mData, mCapacity - 1, mHead + mCount);
+	}
+
+	ConstIterator end() const noexcept
+	{
+		return ConstIterator(mData, mCapacity - 1, mHead + mCount);
+	}
+
+	ReverseIterator rbegin() noexcept
+	{
+		return ReverseIterator(end());
+	}
+
+	ConstReverseIterator rbegin() const noexcept
+	{
+		return ConstReverseIterator(end());
+	}
+
+	ReverseIterator rend() noexcept
+	{
+		return ReverseIterator(begin());
+	}
+
+	ConstReverseIterator rend() const noexcept
+	{
+		return ConstReverseIterator(begin());
+	}
+
+private:
+	size_t slot(size_t index) const noexcept
+	{
+		return (mHead + index) & (mCapacity - 1);
+	}
+
+	bool isAtLimit() const noexcept
+	{
+		return mLimit != 0 && mCount == mLimit;
+	}
+
+	// True when a new element fits without evicting or reallocating.
+	bool hasFreeSlot() const noexcept
+	{
+		return !isAtLimit() && mCount < mCapacity;
+	}
+
+	void checkRange(size_t index) const
+	{
+		if (index >= mCount)
+		{
+			throw std::out_of_range("CircularArray index out of range");
+		}
+	}
+
+	// Same 1.5x policy as Array, rounded up to a power of two so indices can be masked.
+	void ensureCapacity(size_t minCapacity)
+	{
+		if (minCapacity > mCapacity)
+		{
+			size_t grow = mCapacity + (mCapacity >> 1);
+			size_t newCapacity = std::max(minCapacity, mCapacity == 0 ? 8 : grow);
+			reallocate(std::bit_ceil(newCapacity));
+		}
+	}
+
+	void reallocate(size_t newCapacity)
+	{
+		if (newCapacity == 0)
+		{
+			cleanup();
+			return;
+		}
+
+		T* newData = static_cast<T*>(::operator new(sizeof(T) * newCapacity));
+
+		if (mData)
+		{
+			for (size_t i = 0; i < mCount; ++i)
+			{
+				T* source = mData + slot(i);
+				std::construct_at(newData + i, std::move(*source));
+				std::destroy_at(source);
+			}
+			::operator delete(mData);
+		}
+
+		mData = newData;
+		mHead = 0;
+		mCapacity = newCapacity;
+	}
+
+	void cleanup() noexcept
+	{
+		if (mData)
+		{
+			Clear();
+			::operator delete(mData);
+			mData = nullptr;
+			mCapacity = 0;
+		}
+	}
+
+private:
+	T* mData;
+	size_t mHead;
+	size_t mCount;
+	size_t mCapacity;
+	size_t mLimit;
+};
+
+template <typename T>
+class CircularArrayIterator
+{
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = std::remove_const_t<T>;
+	using difference_type = ptrdiff_t;
+	using pointer = T*;
+	using reference = T&;
+
+public:
+	CircularArrayIterator() noexcept
+		: mData(nullptr)
+		, mMask(0)
+		, mPosition(0)
+	{
+	}
+
+	CircularArrayIterator(T* data, size_t mask, size_t position) noexcept
+		: mData(data)
+		, mMask(mask)
+		, mPosition(position)
+	{
+	}
+
+	template<typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+	CircularArrayIterator(const CircularArrayIterator<std::remove_const_t<T>>& other) noexcept
+		: mData(other.mData)
+		, mMask(other.mMask)
+		, mPosition(other.mPosition)
+	{
+	}
+
+public:
+	T& operator*() const noexcept
+	{
+		return mData[mPosition & mMask];
+	}
+
+	T* operator->() const noexcept
+	{
+		return mData + (mPosition & mMask);
+	}
+
+	T& operator[](size_t index) const noexcept
+	{
+		return mData[(mPosition + index) & mMask];
+	}
+
+	CircularArrayIterator& operator++() noexcept
+	{
+		++mPosition;
+		return *this;
+	}
+
+	CircularArrayIterator operator++(int) noexcept
+	{
+		CircularArrayIterator temp = *this;
+		++mPosition;
+		return temp;
+	}
+
+	CircularArrayIterator& operator--() noexcept
+	{
+		--mPosition;
+		return *this;
+	}
+
+	CircularArrayIterator operator--(int) noexcept
+	{
+		CircularArrayIterator temp = *this;
+		--mPosition;
+		return temp;
+	}
+
+	CircularArrayIterator& operator+=(ptrdiff_t n) noexcept
+	{
+		mPosition += n;
+		return *this;
+	}
+
+	CircularArrayIterator& operator-=(ptrdiff_t n) noexcept
+	{
+		mPosition -= n;
+		return *this;
+	}
+
+	CircularArrayIterator operator+(size_t n) const noexcept
+	{
+		return CircularArrayIterator(mData, mMask, mPosition + n);
+	}
+
+	CircularArrayIterator operator-(size_t n) const noexcept
+	{
+		return CircularArrayIterator(mData, mMask, mPosition - n);
+	}
+
+	ptrdiff_t operator-(const CircularArrayIterator& other) const noexcept
+	{
+		return static_cast<ptrdiff_t>(mPosition - other.mPosition);
+	}
+
+	bool operator==(const CircularArrayIterator& other) const noexcept
+	{
+		return mPosition == other.mPosition;
+	}
+
+	bool operator!=(const CircularArrayIterator& other) const noexcept
+	{
+		return mPosition != other.mPosition;
+	}
+
+	std::strong_ordering operator<=>(const CircularArrayIterator& other) const noexcept
+	{
+		return mPosition <=> other.mPosition;
+	}
+
+private:
+	friend class CircularArrayIterator<const T>;
+
+	T* mData;
+	size_t mMask;
+	size_t mPosition;
+};
+
+} // namespace abouttt
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "BasicCompactArray.h"
+
+namespace abouttt
+{
+
+// Storage for CompactArray: the pointer plus a 32-bit count and capacity held inline.
+template <typename T>
+class CompactArrayStorage
+{
+public:
+	static constexpr const char* NAME = "CompactArray";
+
+public:
+	CompactArrayStorage() noexcept
+		: mData(nullptr)
+		, mCount(0)
+		, mCapacity(0)
+	{
+	}
+
+	CompactArrayStorage(CompactArrayStorage&& other) noexcept
+		: mData(std::exchange(other.mData, nullptr))
+		, mCount(std::exchange(other.mCount, 0))
+		, mCapacity(std::exchange(other.mCapacity, 0))
+	{
+	}
+
+	CompactArrayStorage(const CompactArrayStorage&) = delete;
+	CompactArrayStorage& operator=(const CompactArrayStorage&) = delete;
+
+public:
+	size_t Capacity() const noexcept
+	{
+		return mCapacity;
+	}
+
+	size_t Count() const noexcept
+	{
+		return mCount;
+	}
+
+	T* Data() const noexcept
+	{
+		return mData;
+	}
+
+	void Reallocate(size_t newCapacity)
+	{
+		if (newCapacity == 0)
+		{
+			Release();
+			return;
+		}
+
+		T* newData = static_cast<T*>(::operator new(sizeof(T) * newCapacity));
+
+		if (mData)
+		{
+			std::uninitialized_move_n(mData, mCount, newData);
+			std::destroy_n(mData, mCount);
+			::operator delete(mData);
+		}
+
+		mData = newData;
+		mCapacity = static_cast<uint32_t>(newCapacity);
+	}
+
+	void Release() noexcept
+	{
+		if (mData)
+		{
+			std::destroy_n(mData, mCount);
+			::operator delete(mData);
+			mData = nullptr;
+			mCount = 0;
+			mCapacity = 0;
+		}
+	}
+
+	void SetCount(size_t count) noexcept
+	{
+		mCount = static_cast<uint32_t>(count);
+	}
+
+	void Swap(CompactArrayStorage& other) noexcept
+	{
+		std::swap(mData, other.mData);
+		std::swap(mCount, other.mCount);
+		std::swap(mCapacity, other.mCapacity);
+	}
+
+private:
+	T* mData;
+	uint32_t mCount;
+	uint32_t mCapacity;
+};
+
+// Array with a 32-bit count and capacity, so the handle is 16 bytes instead of 24. Holds at
+// most MAX_COUNT elements; growing past that throws std::length_error.
+template <typename T>
+using CompactArray = BasicCompactArray<T, CompactArrayStorage<T>>;
+
+} // namespace abouttt
@@ -0,0 +1,654 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+template <typename T>
+class DequeIterator;
+
+template <typename T>
+class Deque
+{
+public:
+	using Iterator = DequeIterator<T>;
+	using ConstIterator = DequeIterator<const T>;
+	using ReverseIterator = std::reverse_iterator<Iterator>;
+	using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+public:
+	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
+	static constexpr size_t BLOCK_SIZE = std::bit_ceil(std::max<size_t>(16, 4096 / sizeof(T)));
+
+public:
+	Deque() noexcept
+		: mMap()
+		, mSpareBlocks()
+		, mHead(0)
+		, mCount(0)
+	{
+	}
+
+	Deque(std::initializer_list<T> ilist)
+		: Deque()
+	{
+		PushBack(ilist.begin(), ilist.size());
+	}
+
+	Deque(const Deque& other)
+		: Deque()
+	{
+		for (const T& value : other)
+		{
+			PushBack(value);
+		}
+	}
+
+	Deque(Deque&& other) noexcept
+		: mMap(std::move(other.mMap))
+		, mSpareBlocks(std::move(other.mSpareBlocks))
+		, mHead(std::exchange(other.mHead, 0))
+		, mCount(std::exchange(other.mCount, 0))
+	{
+	}
+
+	~Deque()
+	{
+		cleanup();
+	}
+
+public:
+	Deque& operator=(const Deque& other)
+	{
+		if (this != &other)
+		{
+			Deque temp(other);
+			Swap(temp);
+		}
+		return *this;
+	}
+
+	Deque& operator=(Deque&& other) noexcept
+	{
+		if (this != &other)
+		{
+			cleanup();
+			mMap = std::move(other.mMap);
+			mSpareBlocks = std::move(other.mSpareBlocks);
+			mHead = std::exchange(other.mHead, 0);
+			mCount = std::exchange(other.mCount, 0);
+		}
+		return *this;
+	}
+
+	T& operator[](size_t index)
+	{
+		checkRange(index);
+		return *at(mHead + index);
+	}
+
+	const T& operator[](size_t index) const
+	{
+		checkRange(index);
+		return *at(mHead + index);
+	}
+
+public:
+	T& Back()
+	{
+		checkRange(0);
+		return *at(mHead + mCount - 1);
+	}
+
+	const T& Back() const
+	{
+		checkRange(0);
+		return *at(mHead + mCount - 1);
+	}
+
+	void Clear()
+	{
+		while (mCount > 0)
+		{
+			popBackUnchecked();
+		}
+	}
+
+	size_t Count() const noexcept
+	{
+		return mCount;
+	}
+
+	template <typename... Args>
+	T& EmplaceBack(Args&&... args)
+	{
+		size_t position = mHead + mCount;
+		if (position / BLOCK_SIZE == mMap.Count())
+		{
+			growMap();
+			position = mHead + mCount;
+		}
+
+		T* slot = acquire(position);
+		std::construct_at(slot, std::forward<Args>(args)...);
+		++mCount;
+
+		return *slot;
+	}
+
+	template <typename... Args>
+	T& EmplaceFront(Args&&... args)
+	{
+		if (mHead == 0)
+		{
+			growMap();
+		}
+
+		T* slot = acquire(mHead - 1);
+		std::construct_at(slot, std::forward<Args>(args)...);
+		--mHead;
+		++mCount;
+
+		return *slot;
+	}
+
+	size_t Find(const T& value) const
+	{
+		return FindIf([&value](const T& element) { return element == value; });
+	}
+
+	template <typename Predicate>
+	size_t FindIf(Predicate pred) const
+	{
+		for (size_t i = 0; i < mCount; ++i)
+		{
+			if (pred(*at(mHead + i)))
+			{
+				return i;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	T& Front()
+	{
+		checkRange(0);
+		return *at(mHead);
+	}
+
+	const T& Front() const
+	{
+		checkRange(0);
+		return *at(mHead);
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return mCount == 0;
+	}
+
+	void PopBack()
+	{
+		checkRange(0);
+		popBackUnchecked();
+	}
+
+	void PopBack(size_t count)
+	{
+		checkCount(count);
+		while (count-- > 0)
+		{
+			popBackUnchecked();
+		}
+	}
+
+	// Moves the last count elements into out, which must hold count constructed objects, in
+	// order, so out[count - 1] receives the old back. Elements move a block-sized run at a time.
+	void PopBack(T* out, size_t count)
+	{
+		checkCount(count);
+		while (count > 0)
+		{
+			size_t end = mHead + mCount;
+			size_t run = std::min(count, (end - 1) % BLOCK_SIZE + 1);
+			T* first = at(end - run);
+			std::move(first, first + run, out + count - run);
+			std::destroy_n(first, run);
+			mCount -= run;
+			count -= run;
+			if (mCount == 0 || (end - run) % BLOCK_SIZE == 0)
+			{
+				release((end - 1) / BLOCK_SIZE);
+			}
+		}
+		if (mCount == 0)
+		{
+			recentre();
+		}
+	}
+
+	void PopFront()
+	{
+		checkRange(0);
+		popFrontUnchecked();
+	}
+
+	void PopFront(size_t count)
+	{
+		checkCount(count);
+		while (count-- > 0)
+		{
+			popFrontUnchecked();
+		}
+	}
+
+	// Moves the first count elements into out, which must hold count constructed objects, so
+	// out[0] receives the old front.
+	void PopFront(T* out, size_t count)
+	{
+		checkCount(count);
+		while (count > 0)
+		{
+			size_t run = std::min(count, BLOCK_SIZE - mHead % BLOCK_SIZE);
+			T* first = at(mHead);
+			std::move(first, first + run, out);
+			std::destroy_n(first, run);
+			mHead += run;
+			mCount -= run;
+			out += run;
+			count -= run;
+			if (mCount == 0 || mHead % BLOCK_SIZE == 0)
+			{
+				release((mHead - 1) / BLOCK_SIZE);
+			}
+		}
+		if (mCount == 0)
+		{
+			recentre();
+		}
+	}
+
+	void PushBack(const T& value)
+	{
+		EmplaceBack(value);
+	}
+
+	void PushBack(T&& value)
+	{
+		EmplaceBack(std::move(value));
+	}
+
+	// Copies block-sized runs at a time instead of going through the per-element path.
+	void PushBack(const T* ptr, size_t count)
+	{
+		while (count > 0)
+		{
+			size_t position = mHead + mCount;
+			if (position / BLOCK_SIZE == mMap.Count())
+			{
+				growMap();
+				position = mHead + mCount;
+			}
+
+			size_t run = std::min(count, BLOCK_SIZE - position % BLOCK_SIZE);
+			std::uninitialized_copy_n(ptr, run, acquire(position));
+			mCount += run;
+			ptr += run;
+			count -= run;
+		}
+	}
+
+	void PushFront(const T& value)
+	{
+		EmplaceFront(value);
+	}
+
+	void PushFront(T&& value)
+	{
+		EmplaceFront(std::move(value));
+	}
+
+	// Keeps the order of the span, so ptr[0] becomes the new front.
+	void PushFront(const T* ptr, size_t count)
+	{
+		while (count > 0)
+		{
+			if (mHead == 0)
+			{
+				growMap();
+			}
+
+			size_t run = std::min(count, (mHead - 1) % BLOCK_SIZE + 1);
+			std::uninitialized_copy_n(ptr + count - run, run, acquire(mHead - 1) - (run - 1));
+			mHead -= run;
+			mCount += run;
+			count -= run;
+		}
+	}
+
+	void Shrink()
+	{
+		for (T* block : mSpareBlocks)
+		{
+			::operator delete(block);
+		}
+		mSpareBlocks.Clear();
+		mSpareBlocks.Shrink();
+	}
+
+	void Swap(Deque& other) noexcept
+	{
+		mMap.Swap(other.mMap);
+		mSpareBlocks.Swap(other.mSpareBlocks);
+		std::swap(mHead, other.mHead);
+		std::swap(mCount, other.mCount);
+	}
+
+public: // Iterators for range-based loop support.
+	Iterator begin() noexcept
+	{
+		return Iterator(mMap.Data(), mHead);
+	}
+
+	ConstIterator begin() const noexcept
+	{
+		return ConstIterator(mMap.Data(), mHead);
+	}
+
+	Iterator end() noexcept
+	{
+		return Iterator(mMap.Data(), mHead + mCount);
+	}
+
+	ConstIterator end() const noexcept
+	{
+		return ConstIterator(mMap.Data(), mHead + mCount);
+	}
+
+	ReverseIterator rbegin() noexcept
+	{
+		return ReverseIterator(end());
+	}
+
+	ConstReverseIterator rbegin() const noexcept
+	{
+		return ConstReverseIterator(end());
+	}
+
+	ReverseIterator rend() noexcept
+	{
+		return ReverseIterator(begin());
+	}
+
+	ConstReverseIterator rend() const noexcept
+	{
+		return ConstReverseIterator(begin());
+	}
+
+private:
+	T* at(size_t position) const noexcept
+	{
+		return mMap.Data()[position / BLOCK_SIZE] + position % BLOCK_SIZE;
+	}
+
+	// Returns the address for position, taking a block from the spare list (or allocating one)
+	// when the position starts a map slot that has no block yet.
+	T* acquire(size_t position)
+	{
+		T*& block = mMap.Data()[position / BLOCK_SIZE];
+		if (block == nullptr)
+		{
+			if (mSpareBlocks.IsEmpty())
+			{
+				block = static_cast<T*>(::operator new(sizeof(T) * BLOCK_SIZE));
+			}
+			else
+			{
+				block = mSpareBlocks[mSpareBlocks.Count() - 1];
+				mSpareBlocks.RemoveAt(mSpareBlocks.Count() - 1);
+			}
+		}
+		return block + position % BLOCK_SIZE;
+	}
+
+	void release(size_t slot)
+	{
+		T*& block = mMap.Data()[slot];
+		mSpareBlocks.Add(block);
+		block = nullptr;
+	}
+
+	void popBackUnchecked()
+	{
+		size_t position = mHead + mCount - 1;
+		std::destroy_at(at(position));
+		--mCount;
+		if (mCount == 0 || position % BLOCK_SIZE == 0)
+		{
+			release(position / BLOCK_SIZE);
+		}
+		if (mCount == 0)
+		{
+			recentre();
+		}
+	}
+
+	void popFrontUnchecked()
+	{
+		std::destroy_at(at(mHead));
+		++mHead;
+		--mCount;
+		if (mCount == 0 || mHead % BLOCK_SIZE == 0)
+		{
+			release((mHead - 1) / BLOCK_SIZE);
+		}
+		if (mCount == 0)
+		{
+			recentre();
+		}
+	}
+
+	void recentre() noexcept
+	{
+		mHead = mMap.Count() / 2 * BLOCK_SIZE + BLOCK_SIZE / 2;
+	}
+
+	// Rebuilds the map with free slots on both sides of the occupied ones, so pushes at
+	// either end stay amortized O(1) and only block pointers are copied.
+	void growMap()
+	{
+		size_t firstSlot = mHead / BLOCK_SIZE;
+		size_t usedSlots = mCount == 0 ? 0 : (mHead + mCount - 1) / BLOCK_SIZE - firstSlot + 1;
+		size_t newSlots = std::max<size_t>(8, usedSlots * 2 + 2);
+		size_t newFirstSlot = (newSlots - usedSlots) / 2;
+
+		Array<T*> newMap(newSlots);
+		newMap.Resize(newSlots, nullptr);
+		std::copy_n(mMap.Data() + std::min(firstSlot, mMap.Count()), usedSlots, newMap.Data() + newFirstSlot);
+
+		mHead = mCount == 0 ? newSlots / 2 * BLOCK_SIZE + BLOCK_SIZE / 2 : newFirstSlot * BLOCK_SIZE + mHead % BLOCK_SIZE;
+		mMap.Swap(newMap);
+	}
+
+	void checkRange(size_t index) const
+	{
+		if (index >= mCount)
+		{
+			throw std::out_of_range("Deque index out of range");
+		}
+	}
+
+	void checkCount(size_t count) const
+	{
+		if (count > mCount)
+		{
+			throw std::out_of_range("Deque count out of range");
+		}
+	}
+
+	void cleanup() noexcept
+	{
+		for (size_t i = 0; i < mCount; ++i)
+		{
+			std::destroy_at(at(mHead + i));
+		}
+		for (T* block : mMap)
+		{
+			::operator delete(block);
+		}
+		for (T* block : mSpareBlocks)
+		{
+			::operator delete(block);
+		}
+		mMap.Clear();
+		mSpareBlocks.Clear();
+		mHead = 0;
+		mCount = 0;
+	}
+
+private:
+	Array<T*> mMap;
+	Array<T*> mSpareBlocks;
+	size_t mHead;
+	size_t mCount;
+};
+
+template <typename T>
+class DequeIterator
+{
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = std::remove_const_t<T>;
+	using difference_type = ptrdiff_t;
+	using pointer = T*;
+	using reference = T&;
+
+public:
+	static constexpr size_t BLOCK_SIZE = Deque<value_type>::BLOCK_SIZE;
+
+public:
+	DequeIterator() noexcept
+		: mMap(nullptr)
+		, mPosition(0)
+	{
+	}
+
+	DequeIterator(T* const* map, size_t position) noexcept
+		: mMap(map)
+		, mPosition(position)
+	{
+	}
+
+	template<typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+	DequeIterator(const DequeIterator<std::remove_const_t<T>>& other) noexcept
+		: mMap(other.mMap)
+		, mPosition(other.mPosition)
+	{
+	}
+
+public:
+	T& operator*() const noexcept
+	{
+		return mMap[mPosition / BLOCK_SIZE][mPosition % BLOCK_SIZE];
+	}
+
+	T* operator->() const noexcept
+	{
+		return &**this;
+	}
+
+	T& operator[](size_t index) const noexcept
+	{
+		return *(*this + index);
+	}
+
+	DequeIterator& operator++() noexcept
+	{
+		++mPosition;
+		return *this;
+	}
+
+	DequeIterator operator++(int) noexcept
+	{
+		DequeIterator temp = *this;
+		++mPosition;
+		return temp;
+	}
+
+	DequeIterator& operator--() noexcept
+	{
+		--mPosition;
+		return *this;
+	}
+
+	DequeIterator operator--(int) noexcept
+	{
+		DequeIterator temp = *this;
+		--mPosition;
+		return temp;
+	}
+
+	DequeIterator& operator+=(ptrdiff_t n) noexcept
+	{
+		mPosition += n;
+		return *this;
+	}
+
+	DequeIterator& operator-=(ptrdiff_t n) noexcept
+	{
+		mPosition -= n;
+		return *this;
+	}
+
+	DequeIterator operator+(size_t n) const noexcept
+	{
+		return DequeIterator(mMap, mPosition + n);
+	}
+
+	DequeIterator operator-(size_t n) const noexcept
+	{
+		return DequeIterator(mMap, mPosition - n);
+	}
+
+	ptrdiff_t operator-(const DequeIterator& other) const noexcept
+	{
+		return static_cast<ptrdiff_t>(mPosition) - static_cast<ptrdiff_t>(other.mPosition);
+	}
+
+	bool operator==(const DequeIterator& other) const noexcept
+	{
+		return mPosition == other.mPosition;
+	}
+
+	bool operator!=(const DequeIterator& other) const noexcept
+	{
+		return mPosition != other.mPosition;
+	}
+
+	std::strong_ordering operator<=>(const DequeIterator& other) const noexcept
+	{
+		return mPosition <=> other.mPosition;
+	}
+
+private:
+	friend class DequeIterator<const T>;
+
+	T* const* mMap;
+	size_t mPosition;
+};
+
+} // namespace abouttt
@@ -0,0 +1,337 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+template <typename T, typename Hash = std::hash<T>>
+class DictionaryArray
+{
+public:
+	using Code = uint32_t;
+
+public:
+	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
+
+public:
+	DictionaryArray()
+		: mDictionary()
+		, mSlots()
+		, mCodes(Array<uint8_t>())
+	{
+	}
+
+public:
+	const T& operator[](size_t index) const
+	{
+		return Get(index);
+	}
+
+public:
+	void Add(const T& value)
+	{
+		Code code = encode(value);
+		std::visit([code](auto& codes) { codes.Add(narrow(codes, code)); }, mCodes);
+	}
+
+	size_t Cardinality() const noexcept
+	{
+		return mDictionary.Count();
+	}
+
+	void Clear() noexcept
+	{
+		mDictionary.Clear();
+		mSlots.Clear();
+		mCodes = Array<uint8_t>();
+	}
+
+	Code CodeAt(size_t index) const
+	{
+		checkRange(index);
+		return std::visit([index](const auto& codes) { return static_cast<Code>(codes.Data()[index]); }, mCodes);
+	}
+
+	size_t CodeWidth() const noexcept
+	{
+		return std::visit([](const auto& codes) { return sizeof(*codes.Data()); }, mCodes);
+	}
+
+	size_t Count() const noexcept
+	{
+		return std::visit([](const auto& codes) { return codes.Count(); }, mCodes);
+	}
+
+	size_t CountValue(const T& value) const
+	{
+		Code code = lookup(value);
+		return code != CODE_NONE ? countCode(code) : 0;
+	}
+
+	// Evaluates the predicate once per distinct value, then scans only the codes.
+	template <typename Predicate>
+	size_t CountIf(Predicate pred) const
+	{
+		Array<uint8_t> matches = matchCodes(pred);
+		return std::visit([&matches](const auto& codes)
+			{
+				const uint8_t* match = matches.Data();
+				size_t result = 0;
+				for (size_t i = 0, n = codes.Count(); i < n; ++i)
+				{
+					result += match[codes.Data()[i]];
+				}
+				return result;
+			}, mCodes);
+	}
+
+	const Array<T>& Dictionary() const noexcept
+	{
+		return mDictionary;
+	}
+
+	size_t Find(const T& value) const
+	{
+		Code code = lookup(value);
+		return code != CODE_NONE ? findCode(code) : INDEX_NONE;
+	}
+
+	template <typename Predicate>
+	size_t FindIf(Predicate pred) const
+	{
+		Array<uint8_t> matches = matchCodes(pred);
+		return std::visit([&matches](const auto& codes)
+			{
+				const uint8_t* match = matches.Data();
+				for (size_t i = 0, n = codes.Count(); i < n; ++i)
+				{
+					if (match[codes.Data()[i]])
+					{
+						return i;
+					}
+				}
+				return INDEX_NONE;
+			}, mCodes);
+	}
+
+	template <typename Function>
+	void ForEach(Function func) const
+	{
+		std::visit([this, &func](const auto& codes)
+			{
+				for (size_t i = 0, n = codes.Count(); i < n; ++i)
+				{
+					func(mDictionary.Data()[codes.Data()[i]]);
+				}
+			}, mCodes);
+	}
+
+	const T& Get(size_t index) const
+	{
+		return mDictionary.Data()[CodeAt(index)];
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return Count() == 0;
+	}
+
+	void Reserve(size_t newCapacity)
+	{
+		std::visit([newCapacity](auto& codes) { codes.Reserve(newCapacity); }, mCodes);
+	}
+
+	void Set(size_t index, const T& value)
+	{
+		checkRange(index);
+		Code code = encode(value);
+		std::visit([index, code](auto& codes) { codes.Data()[index] = narrow(codes, code); }, mCodes);
+	}
+
+private:
+	using Codes = std::variant<Array<uint8_t>, Array<uint16_t>, Array<uint32_t>>;
+
+	// Lookup table entry; values live only in mDictionary, so each distinct value is stored once.
+	struct Slot
+	{
+		uint32_t ValueHash;
+		Code DictionaryCode;
+	};
+
+	static constexpr Code CODE_NONE = std::numeric_limits<Code>::max();
+
+	static uint32_t hashOf(const T& value)
+	{
+		uint64_t hash = Hash()(value);
+		return static_cast<uint32_t>(hash ^ (hash >> 32));
+	}
+
+	// Returns the code for value, adding it to the dictionary and widening the code
+	// Array when the new code no longer fits in the current code type. Every step that can
+	// throw runs before the value becomes visible, so a failure leaves the array unchanged.
+	Code encode(const T& value)
+	{
+		ensureSlots(mDictionary.Count() + 1);
+
+		uint32_t hash = hashOf(value);
+		Slot& slot = mSlots.Data()[findSlot(value, hash)];
+		if (slot.DictionaryCode != CODE_NONE)
+		{
+			return slot.DictionaryCode;
+		}
+
+		Code code = static_cast<Code>(mDictionary.Count());
+		if (code > std::numeric_limits<uint8_t>::max() && mCodes.index() == 0)
+		{
+			mCodes = widen<uint16_t>(std::get<0>(mCodes));
+		}
+		if (code > std::numeric_limits<uint16_t>::max() && mCodes.index() == 1)
+		{
+			mCodes = widen<uint32_t>(std::get<1>(mCodes));
+		}
+
+		mDictionary.Add(value);
+		slot.ValueHash = hash;
+		slot.DictionaryCode = code;
+		return code;
+	}
+
+	Code lookup(const T& value) const
+	{
+		if (mSlots.IsEmpty())
+		{
+			return CODE_NONE;
+		}
+		return mSlots.Data()[findSlot(value, hashOf(value))].DictionaryCode;
+	}
+
+	// Linear probing: returns the slot holding value, or the empty slot where it belongs.
+	size_t findSlot(const T& value, uint32_t hash) const
+	{
+		const Slot* slots = mSlots.Data();
+		size_t mask = mSlots.Count() - 1;
+		for (size_t i = hash & mask; ; i = (i + 1) & mask)
+		{
+			const Slot& slot = slots[i];
+			if (slot.DictionaryCode == CODE_NONE
+				|| (slot.ValueHash == hash && mDictionary.Data()[slot.DictionaryCode] == value))
+			{
+				return i;
+			}
+		}
+	}
+
+	// Keeps the table at most three quarters full, rehashing from the stored hashes.
+	void ensureSlots(size_t minCount)
+	{
+		if (minCount >= CODE_NONE)
+		{
+			throw std::length_error("DictionaryArray cardinality exceeds code range");
+		}
+		if (minCount * 4 <= mSlots.Count() * 3)
+		{
+			return;
+		}
+
+		size_t newCapacity = std::bit_ceil(std::max<size_t>(16, (minCount * 4 + 2) / 3));
+		Array<Slot> slots;
+		slots.Resize(newCapacity, Slot{ 0, CODE_NONE });
+
+		size_t mask = newCapacity - 1;
+		for (const Slot& slot : mSlots)
+		{
+			if (slot.DictionaryCode != CODE_NONE)
+			{
+				size_t i = slot.ValueHash & mask;
+				while (slots.Data()[i].DictionaryCode != CODE_NONE)
+				{
+					i = (i + 1) & mask;
+				}
+				slots.Data()[i] = slot;
+			}
+		}
+		mSlots.Swap(slots);
+	}
+
+	template <typename U>
+	static U narrow(const Array<U>&, Code code) noexcept
+	{
+		return static_cast<U>(code);
+	}
+
+	template <typename U, typename V>
+	static Array<U> widen(const Array<V>& codes)
+	{
+		Array<U> result(codes.Capacity());
+		for (V code : codes)
+		{
+			result.Add(static_cast<U>(code));
+		}
+		return result;
+	}
+
+	template <typename Predicate>
+	Array<uint8_t> matchCodes(Predicate pred) const
+	{
+		Array<uint8_t> matches(mDictionary.Count());
+		for (const T& value : mDictionary)
+		{
+			matches.Add(pred(value) ? 1 : 0);
+		}
+		return matches;
+	}
+
+	size_t countCode(Code code) const
+	{
+		return std::visit([code](const auto& codes)
+			{
+				size_t result = 0;
+				for (size_t i = 0, n = codes.Count(); i < n; ++i)
+				{
+					result += codes.Data()[i] == code;
+				}
+				return result;
+			}, mCodes);
+	}
+
+	size_t findCode(Code code) const
+	{
+		return std::visit([code](const auto& codes)
+			{
+				for (size_t i = 0, n = codes.Count(); i < n; ++i)
+				{
+					if (codes.Data()[i] == code)
+					{
+						return i;
+					}
+				}
+				return INDEX_NONE;
+			}, mCodes);
+	}
+
+	void checkRange(size_t index) const
+	{
+		if (index >= Count())
+		{
+			throw std::out_of_range("DictionaryArray index out of range");
+		}
+	}
+
+private:
+	Array<T> mDictionary;
+	Array<Slot> mSlots;
+	Codes mCodes;
+};
+
+} // namespace abouttt
@@ -0,0 +1,305 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+template <typename T>
+class GapBuffer
+{
+	static_assert(std::is_trivially_copyable_v<T>, "GapBuffer moves elements with memmove");
+
+public:
+	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
+
+public:
+	GapBuffer() noexcept
+		: GapBuffer(0)
+	{
+	}
+
+	explicit GapBuffer(size_t capacity)
+		: mData(capacity > 0 ? static_cast<T*>(::operator new(sizeof(T) * capacity)) : nullptr)
+		, mGapStart(0)
+		, mGapEnd(capacity)
+		, mCapacity(capacity)
+	{
+	}
+
+	GapBuffer(std::initializer_list<T> ilist)
+		: GapBuffer(ilist.size())
+	{
+		Insert(0, ilist.begin(), ilist.size());
+	}
+
+	GapBuffer(const GapBuffer& other)
+		: GapBuffer(other.Count())
+	{
+		std::copy_n(other.mData, other.mGapStart, mData);
+		std::copy_n(other.mData + other.mGapEnd, other.tailCount(), mData + other.mGapStart);
+		mGapStart = other.Count();
+		mGapEnd = mCapacity;
+	}
+
+	GapBuffer(GapBuffer&& other) noexcept
+		: mData(std::exchange(other.mData, nullptr))
+		, mGapStart(std::exchange(other.mGapStart, 0))
+		, mGapEnd(std::exchange(other.mGapEnd, 0))
+		, mCapacity(std::exchange(other.mCapacity, 0))
+	{
+	}
+
+	~GapBuffer()
+	{
+		::operator delete(mData);
+	}
+
+public:
+	GapBuffer& operator=(const GapBuffer& other)
+	{
+		if (this != &other)
+		{
+			GapBuffer temp(other);
+			Swap(temp);
+		}
+		return *this;
+	}
+
+	GapBuffer& operator=(GapBuffer&& other) noexcept
+	{
+		if (this != &other)
+		{
+			::operator delete(mData);
+			mData = std::exchange(other.mData, nullptr);
+			mGapStart = std::exchange(other.mGapStart, 0);
+			mGapEnd = std::exchange(other.mGapEnd, 0);
+			mCapacity = std::exchange(other.mCapacity, 0);
+		}
+		return *this;
+	}
+
+	T& operator[](size_t index)
+	{
+		checkRange(index);
+		return mData[physical(index)];
+	}
+
+	const T& operator[](size_t index) const
+	{
+		checkRange(index);
+		return mData[physical(index)];
+	}
+
+public:
+	void Add(const T& value)
+	{
+		Insert(Count(), value);
+	}
+
+	size_t Capacity() const noexcept
+	{
+		return mCapacity;
+	}
+
+	void Clear() noexcept
+	{
+		mGapStart = 0;
+		mGapEnd = mCapacity;
+	}
+
+	size_t Count() const noexcept
+	{
+		return mCapacity - (mGapEnd - mGapStart);
+	}
+
+	size_t Cursor() const noexcept
+	{
+		return mGapStart;
+	}
+
+	size_t Find(const T& value) const
+	{
+		return FindIf([&value](const T& element) { return element == value; });
+	}
+
+	template <typename Predicate>
+	size_t FindIf(Predicate pred) const
+	{
+		const T* it = std::find_if(mData, mData + mGapStart, pred);
+		if (it != mData + mGapStart)
+		{
+			return static_cast<size_t>(it - mData);
+		}
+		it = std::find_if(mData + mGapEnd, mData + mCapacity, pred);
+		return it != mData + mCapacity ? static_cast<size_t>(it - mData) - (mGapEnd - mGapStart) : INDEX_NONE;
+	}
+
+	size_t Insert(size_t index, const T& value)
+	{
+		return Insert(index, &value, 1);
+	}
+
+	size_t Insert(size_t index, std::span<const T> values)
+	{
+		return Insert(index, values.data(), values.size());
+	}
+
+	// Moves the gap to index (a no-op for consecutive edits at the cursor) and copies the
+	// values into it, growing the gap first when it is too small.
+	size_t Insert(size_t index, const T* ptr, size_t count)
+	{
+		checkRange(index, true);
+		ensureGap(count);
+		MoveCursor(index);
+		std::copy_n(ptr, count, mData + mGapStart);
+		mGapStart += count;
+		return index;
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return Count() == 0;
+	}
+
+	// Returns the contents as a single contiguous span by closing the gap at the end.
+	std::span<T> Linearize()
+	{
+		MoveCursor(Count());
+		return std::span<T>(mData, mGapStart);
+	}
+
+	void MoveCursor(size_t index)
+	{
+		checkRange(index, true);
+		if (index < mGapStart)
+		{
+			size_t count = mGapStart - index;
+			std::memmove(mData + mGapEnd - count, mData + index, sizeof(T) * count);
+			mGapStart -= count;
+			mGapEnd -= count;
+		}
+		else if (index > mGapStart)
+		{
+			size_t count = index - mGapStart;
+			std::memmove(mData + mGapStart, mData + mGapEnd, sizeof(T) * count);
+			mGapStart += count;
+			mGapEnd += count;
+		}
+	}
+
+	void RemoveAt(size_t index)
+	{
+		RemoveAt(index, 1);
+	}
+
+	void RemoveAt(size_t index, size_t count)
+	{
+		if (count > Count() || index > Count() - count)
+		{
+			throw std::out_of_range("GapBuffer index out of range");
+		}
+		MoveCursor(index);
+		mGapEnd += count;
+	}
+
+	void Reserve(size_t newCapacity)
+	{
+		if (newCapacity > mCapacity)
+		{
+			reallocate(newCapacity);
+		}
+	}
+
+	void Shrink()
+	{
+		if (mCapacity > Count())
+		{
+			reallocate(Count());
+		}
+	}
+
+	void Swap(GapBuffer& other) noexcept
+	{
+		std::swap(mData, other.mData);
+		std::swap(mGapStart, other.mGapStart);
+		std::swap(mGapEnd, other.mGapEnd);
+		std::swap(mCapacity, other.mCapacity);
+	}
+
+	void ToArray(Array<T>& target) const
+	{
+		target.Clear();
+		target.Reserve(Count());
+		target.Append(mData, mGapStart);
+		target.Append(mData + mGapEnd, tailCount());
+	}
+
+private:
+	size_t tailCount() const noexcept
+	{
+		return mCapacity - mGapEnd;
+	}
+
+	size_t physical(size_t index) const noexcept
+	{
+		return index < mGapStart ? index : index + (mGapEnd - mGapStart);
+	}
+
+	void checkRange(size_t index, bool bAllowEnd = false) const
+	{
+		if (index >= Count() + (bAllowEnd ? 1 : 0))
+		{
+			throw std::out_of_range("GapBuffer index out of range");
+		}
+	}
+
+	void ensureGap(size_t minGap)
+	{
+		if (minGap > mGapEnd - mGapStart)
+		{
+			size_t minCapacity = Count() + minGap;
+			size_t grow = mCapacity + (mCapacity >> 1); // Grow by 1.5x
+			size_t newCapacity = std::max(minCapacity, mCapacity == 0 ? 8 : grow);
+			reallocate(newCapacity);
+		}
+	}
+
+	// Keeps the gap at the cursor position, with the tail moved to the end of the new block.
+	void reallocate(size_t newCapacity)
+	{
+		T* newData = newCapacity > 0 ? static_cast<T*>(::operator new(sizeof(T) * newCapacity)) : nullptr;
+		size_t tail = tailCount();
+		size_t newGapEnd = newCapacity - tail;
+
+		if (mData)
+		{
+			std::copy_n(mData, mGapStart, newData);
+			std::copy_n(mData + mGapEnd, tail, newData + newGapEnd);
+			::operator delete(mData);
+		}
+
+		mData = newData;
+		mGapEnd = newGapEnd;
+		mCapacity = newCapacity;
+	}
+
+private:
+	T* mData;
+	size_t mGapStart;
+	size_t mGapEnd;
+	size_t mCapacity;
+};
+
+} // namespace abouttt
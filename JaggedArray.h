@@ -0,0 +1,319 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+// Variable-length rows flattened into one values Array, with row i occupying
+// [offsets[i], offsets[i + 1]). Row access is O(1) and walking every row is a linear scan.
+// The leading zero offset is added with the first row, so an empty JaggedArray owns nothing.
+template <typename T>
+class JaggedArray
+{
+public:
+	JaggedArray() noexcept
+		: mOffsets()
+		, mValues()
+	{
+	}
+
+	JaggedArray(std::initializer_list<std::initializer_list<T>> rows)
+		: JaggedArray()
+	{
+		for (const auto& row : rows)
+		{
+			AppendRow(row.begin(), row.size());
+		}
+	}
+
+public:
+	std::span<T> operator[](size_t row)
+	{
+		return Row(row);
+	}
+
+	std::span<const T> operator[](size_t row) const
+	{
+		return Row(row);
+	}
+
+	bool operator==(const JaggedArray& other) const
+	{
+		return RowCount() == other.RowCount() && (IsEmpty() || mOffsets == other.mOffsets) && mValues == other.mValues;
+	}
+
+public:
+	// Lays out rows with the given sizes in one pass, filled with value.
+	static JaggedArray FromCounts(std::span<const size_t> counts, const T& value = T())
+	{
+		JaggedArray result;
+		result.allocateRows(counts);
+		result.mValues.Resize(result.mOffsets[counts.size()], value);
+		return result;
+	}
+
+	// Lays out rows with the given sizes, then calls fill(row, span) for every row. Rows are
+	// split across threadCount workers (0 picks the hardware concurrency) in ranges of roughly
+	// equal value count. Each worker writes only its own rows, so no locking is needed.
+	template <typename Function>
+	static JaggedArray Build(std::span<const size_t> counts, Function fill, size_t threadCount = 1)
+	{
+		JaggedArray result = FromCounts(counts);
+		size_t rowCount = counts.size();
+		size_t valueCount = result.mValues.Count();
+
+		if (threadCount == 0)
+		{
+			threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+		}
+		threadCount = std::min(threadCount, std::max<size_t>(1, rowCount));
+
+		auto fillRange = [&result, &fill](size_t first, size_t last)
+		{
+			for (size_t row = first; row < last; ++row)
+			{
+				fill(row, result.Row(row));
+			}
+		};
+
+		if (threadCount == 1)
+		{
+			fillRange(0, rowCount);
+			return result;
+		}
+
+		const size_t* offsets = result.mOffsets.Data();
+		Array<std::thread> workers(threadCount);
+		Array<std::exception_ptr> errors;
+		errors.Resize(threadCount);
+
+		auto joinAll = [&workers]()
+		{
+			for (std::thread& worker : workers)
+			{
+				worker.join();
+			}
+		};
+
+		// A failed thread spawn must still join the workers already running, since they
+		// reference locals and destroying a joinable std::thread terminates.
+		try
+		{
+			size_t first = 0;
+			for (size_t i = 0; i < threadCount; ++i)
+			{
+				size_t target = valueCount / threadCount * (i + 1);
+				size_t last = i + 1 == threadCount
+					? rowCount
+					: std::max(first, static_cast<size_t>(std::upper_bound(offsets, offsets + rowCount, target) - offsets));
+
+				workers.Emplace([&fillRange, &errors, i, first, last]()
+				{
+					try
+					{
+						fillRange(first, last);
+					}
+					catch (...)
+					{
+						errors[i] = std::current_exception();
+					}
+				});
+				first = last;
+			}
+		}
+		catch (...)
+		{
+			joinAll();
+			throw;
+		}
+
+		joinAll();
+		for (const std::exception_ptr& error : errors)
+		{
+			if (error)
+			{
+				std::rethrow_exception(error);
+			}
+		}
+		return result;
+	}
+
+public:
+	void AddToLastRow(const T& value)
+	{
+		if (IsEmpty())
+		{
+			throw std::out_of_range("JaggedArray has no rows");
+		}
+		mValues.Add(value);
+		++mOffsets[RowCount()];
+	}
+
+	void AppendRow(const T* ptr, size_t count)
+	{
+		if (mOffsets.IsEmpty())
+		{
+			mOffsets.Add(0);
+		}
+		mValues.Append(ptr, count);
+		mOffsets.Add(mValues.Count());
+	}
+
+	void AppendRow(std::span<const T> row)
+	{
+		AppendRow(row.data(), row.size());
+	}
+
+	void AppendRow(std::initializer_list<T> row)
+	{
+		AppendRow(row.begin(), row.size());
+	}
+
+	void Clear() noexcept
+	{
+		mOffsets.Clear();
+		mValues.Clear();
+	}
+
+	template <typename Function>
+	void ForEachRow(Function func)
+	{
+		for (size_t row = 0, n = RowCount(); row < n; ++row)
+		{
+			func(row, rowSpan(row));
+		}
+	}
+
+	template <typename Function>
+	void ForEachRow(Function func) const
+	{
+		for (size_t row = 0, n = RowCount(); row < n; ++row)
+		{
+			func(row, rowSpan(row));
+		}
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return RowCount() == 0;
+	}
+
+	std::span<const size_t> Offsets() const noexcept
+	{
+		return std::span<const size_t>(mOffsets.Data(), mOffsets.Count());
+	}
+
+	void RemoveLastRow()
+	{
+		if (IsEmpty())
+		{
+			throw std::out_of_range("JaggedArray has no rows");
+		}
+		mOffsets.RemoveAt(RowCount());
+		mValues.Resize(mOffsets[RowCount()]);
+	}
+
+	void Reserve(size_t rowCount, size_t valueCount)
+	{
+		mOffsets.Reserve(rowCount + 1);
+		mValues.Reserve(valueCount);
+	}
+
+	std::span<T> Row(size_t row)
+	{
+		checkRange(row);
+		return rowSpan(row);
+	}
+
+	std::span<const T> Row(size_t row) const
+	{
+		checkRange(row);
+		return rowSpan(row);
+	}
+
+	size_t RowCount() const noexcept
+	{
+		return mOffsets.IsEmpty() ? 0 : mOffsets.Count() - 1;
+	}
+
+	size_t RowSize(size_t row) const
+	{
+		checkRange(row);
+		return mOffsets.Data()[row + 1] - mOffsets.Data()[row];
+	}
+
+	void Shrink()
+	{
+		mOffsets.Shrink();
+		mValues.Shrink();
+	}
+
+	void Swap(JaggedArray& other) noexcept
+	{
+		mOffsets.Swap(other.mOffsets);
+		mValues.Swap(other.mValues);
+	}
+
+	size_t ValueCount() const noexcept
+	{
+		return mValues.Count();
+	}
+
+	std::span<T> Values() noexcept
+	{
+		return std::span<T>(mValues.Data(), mValues.Count());
+	}
+
+	std::span<const T> Values() const noexcept
+	{
+		return std::span<const T>(mValues.Data(), mValues.Count());
+	}
+
+private:
+	void allocateRows(std::span<const size_t> counts)
+	{
+		mOffsets.Resize(counts.size() + 1);
+		size_t* offsets = mOffsets.Data();
+		offsets[0] = 0;
+		for (size_t i = 0; i < counts.size(); ++i)
+		{
+			offsets[i + 1] = offsets[i] + counts[i];
+		}
+	}
+
+	std::span<T> rowSpan(size_t row) noexcept
+	{
+		const size_t* offsets = mOffsets.Data();
+		return std::span<T>(mValues.Data() + offsets[row], offsets[row + 1] - offsets[row]);
+	}
+
+	std::span<const T> rowSpan(size_t row) const noexcept
+	{
+		const size_t* offsets = mOffsets.Data();
+		return std::span<const T>(mValues.Data() + offsets[row], offsets[row + 1] - offsets[row]);
+	}
+
+	void checkRange(size_t row) const
+	{
+		if (row >= RowCount())
+		{
+			throw std::out_of_range("JaggedArray index out of range");
+		}
+	}
+
+private:
+	Array<size_t> mOffsets;
+	Array<T> mValues;
+};
+
+} // namespace abouttt
@@ -0,0 +1,613 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+enum class MDLayout
+{
+	RowMajor,
+	ColumnMajor,
+	Tiled,
+};
+
+// A non-owning strided window into N-dimensional data. Transposes, slices and sub-views only
+// rewrite the shape/stride metadata, so they never copy elements.
+template <typename T, size_t Rank>
+class MDView
+{
+	static_assert(Rank > 0, "MDView requires at least one dimension");
+
+public:
+	using Extents = std::array<size_t, Rank>;
+
+public:
+	static constexpr size_t BLOCK_SIZE = 32;
+
+public:
+	MDView() noexcept
+		: mData(nullptr)
+		, mShape()
+		, mStrides()
+	{
+	}
+
+	MDView(T* data, const Extents& shape, const Extents& strides) noexcept
+		: mData(data)
+		, mShape(shape)
+		, mStrides(strides)
+	{
+	}
+
+	template<typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+	MDView(const MDView<std::remove_const_t<T>, Rank>& other) noexcept
+		: mData(other.Data())
+		, mShape(other.Shape())
+		, mStrides(other.Strides())
+	{
+	}
+
+public:
+	template <typename... Indices>
+	T& operator()(Indices... indices) const
+	{
+		static_assert(sizeof...(Indices) == Rank, "MDView requires one index per dimension");
+		return At(Extents{ static_cast<size_t>(indices)... });
+	}
+
+public:
+	T& At(const Extents& index) const
+	{
+		checkRange(index);
+		return mData[offset(index)];
+	}
+
+	size_t Count() const noexcept
+	{
+		size_t result = 1;
+		for (size_t extent : mShape)
+		{
+			result *= extent;
+		}
+		return result;
+	}
+
+	T* Data() const noexcept
+	{
+		return mData;
+	}
+
+	size_t Extent(size_t dimension) const
+	{
+		checkDimension(dimension);
+		return mShape[dimension];
+	}
+
+	// Visits every element in tiles of BLOCK_SIZE along each dimension, with the dimension of
+	// smallest stride innermost, so strided and transposed views still reuse cache lines.
+	template <typename Function>
+	void ForEach(Function func) const
+	{
+		if (Count() == 0)
+		{
+			return;
+		}
+
+		Extents order;
+		for (size_t d = 0; d < Rank; ++d)
+		{
+			order[d] = d;
+		}
+		std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return mStrides[a] > mStrides[b]; });
+
+		Extents origin{};
+		do
+		{
+			Extents index = origin;
+			do
+			{
+				func(static_cast<const Extents&>(index), mData[offset(index)]);
+			} while (advance(index, order, origin));
+		} while (advanceTile(origin, order));
+	}
+
+	bool IsContiguous() const noexcept
+	{
+		size_t expected = 1;
+		for (size_t d = Rank; d-- > 0; )
+		{
+			if (mShape[d] != 1 && mStrides[d] != expected)
+			{
+				return false;
+			}
+			expected *= mShape[d];
+		}
+		return true;
+	}
+
+	MDView Permute(const Extents& order) const
+	{
+		Extents seen{};
+		Extents shape;
+		Extents strides;
+		for (size_t d = 0; d < Rank; ++d)
+		{
+			checkDimension(order[d]);
+			if (seen[order[d]]++ != 0)
+			{
+				throw std::invalid_argument("MDView permutation repeats a dimension");
+			}
+			shape[d] = mShape[order[d]];
+			strides[d] = mStrides[order[d]];
+		}
+		return MDView(mData, shape, strides);
+	}
+
+	const Extents& Shape() const noexcept
+	{
+		return mShape;
+	}
+
+	template <size_t R = Rank, typename = std::enable_if_t<(R > 1)>>
+	MDView<T, Rank - 1> Slice(size_t dimension, size_t index) const
+	{
+		checkDimension(dimension);
+		if (index >= mShape[dimension])
+		{
+			throw std::out_of_range("MDView index out of range");
+		}
+
+		std::array<size_t, Rank - 1> shape;
+		std::array<size_t, Rank - 1> strides;
+		for (size_t d = 0, j = 0; d < Rank; ++d)
+		{
+			if (d != dimension)
+			{
+				shape[j] = mShape[d];
+				strides[j] = mStrides[d];
+				++j;
+			}
+		}
+		return MDView<T, Rank - 1>(mData + index * mStrides[dimension], shape, strides);
+	}
+
+	const Extents& Strides() const noexcept
+	{
+		return mStrides;
+	}
+
+	MDView SubView(const Extents& offsets, const Extents& extents) const
+	{
+		for (size_t d = 0; d < Rank; ++d)
+		{
+			if (offsets[d] > mShape[d] || extents[d] > mShape[d] - offsets[d])
+			{
+				throw std::out_of_range("MDView sub-view out of range");
+			}
+		}
+		return MDView(mData + offset(offsets), extents, mStrides);
+	}
+
+	MDView Transpose(size_t first, size_t second) const
+	{
+		checkDimension(first);
+		checkDimension(second);
+
+		MDView result = *this;
+		std::swap(result.mShape[first], result.mShape[second]);
+		std::swap(result.mStrides[first], result.mStrides[second]);
+		return result;
+	}
+
+private:
+	size_t offset(const Extents& index) const noexcept
+	{
+		size_t result = 0;
+		for (size_t d = 0; d < Rank; ++d)
+		{
+			result += index[d] * mStrides[d];
+		}
+		return result;
+	}
+
+	// Odometer step inside the tile that starts at origin; returns false after the last element.
+	bool advance(Extents& index, const Extents& order, const Extents& origin) const noexcept
+	{
+		for (size_t k = Rank; k-- > 0; )
+		{
+			size_t d = order[k];
+			size_t limit = std::min(origin[d] + BLOCK_SIZE, mShape[d]);
+			if (++index[d] < limit)
+			{
+				return true;
+			}
+			index[d] = origin[d];
+		}
+		return false;
+	}
+
+	bool advanceTile(Extents& origin, const Extents& order) const noexcept
+	{
+		for (size_t k = Rank; k-- > 0; )
+		{
+			size_t d = order[k];
+			origin[d] += BLOCK_SIZE;
+			if (origin[d] < mShape[d])
+			{
+				return true;
+			}
+			origin[d] = 0;
+		}
+		return false;
+	}
+
+	void checkRange(const Extents& index) const
+	{
+		for (size_t d = 0; d < Rank; ++d)
+		{
+			if (index[d] >= mShape[d])
+			{
+				throw std::out_of_range("MDView index out of range");
+			}
+		}
+	}
+
+	void checkDimension(size_t dimension) const
+	{
+		if (dimension >= Rank)
+		{
+			throw std::out_of_range("MDView dimension out of range");
+		}
+	}
+
+private:
+	T* mData;
+	Extents mShape;
+	Extents mStrides;
+};
+
+template <typename T, size_t Rank>
+class MDArray
+{
+	static_assert(Rank > 0, "MDArray requires at least one dimension");
+
+public:
+	using Extents = std::array<size_t, Rank>;
+	using View = MDView<T, Rank>;
+	using ConstView = MDView<const T, Rank>;
+
+public:
+	static constexpr size_t DEFAULT_TILE_SIZE = 16;
+
+public:
+	MDArray() noexcept
+		: mStorage()
+		, mShape()
+		, mStrides()
+		, mLayout(MDLayout::RowMajor)
+		, mTileSize(DEFAULT_TILE_SIZE)
+	{
+	}
+
+	explicit MDArray(const Extents& shape, MDLayout layout = MDLayout::RowMajor, size_t tileSize = DEFAULT_TILE_SIZE)
+		: mStorage()
+		, mShape(shape)
+		, mStrides()
+		, mLayout(layout)
+		, mTileSize(tileSize)
+	{
+		if (tileSize == 0)
+		{
+			throw std::invalid_argument("MDArray tile size must be positive");
+		}
+		computeStrides();
+		mStorage.Resize(storageCount());
+	}
+
+public:
+	template <typename... Indices>
+	T& operator()(Indices... indices)
+	{
+		static_assert(sizeof...(Indices) == Rank, "MDArray requires one index per dimension");
+		return At(Extents{ static_cast<size_t>(indices)... });
+	}
+
+	template <typename... Indices>
+	const T& operator()(Indices... indices) const
+	{
+		static_assert(sizeof...(Indices) == Rank, "MDArray requires one index per dimension");
+		return At(Extents{ static_cast<size_t>(indices)... });
+	}
+
+public:
+	T& At(const Extents& index)
+	{
+		checkRange(index);
+		return mStorage.Data()[offset(index)];
+	}
+
+	const T& At(const Extents& index) const
+	{
+		checkRange(index);
+		return mStorage.Data()[offset(index)];
+	}
+
+	size_t Count() const noexcept
+	{
+		size_t result = 1;
+		for (size_t extent : mShape)
+		{
+			result *= extent;
+		}
+		return result;
+	}
+
+	T* Data() noexcept
+	{
+		return mStorage.Data();
+	}
+
+	const T* Data() const noexcept
+	{
+		return mStorage.Data();
+	}
+
+	size_t Extent(size_t dimension) const
+	{
+		if (dimension >= Rank)
+		{
+			throw std::out_of_range("MDArray dimension out of range");
+		}
+		return mShape[dimension];
+	}
+
+	void Fill(const T& value)
+	{
+		std::fill(mStorage.begin(), mStorage.end(), value);
+	}
+
+	template <typename Function>
+	void ForEach(Function func)
+	{
+		forEach(*this, func);
+	}
+
+	template <typename Function>
+	void ForEach(Function func) const
+	{
+		forEach(*this, func);
+	}
+
+	MDLayout Layout() const noexcept
+	{
+		return mLayout;
+	}
+
+	// Copies into a new storage Array with the requested layout, walking the source in
+	// cache-sized blocks.
+	void Relayout(MDLayout layout)
+	{
+		if (layout == mLayout)
+		{
+			return;
+		}
+
+		MDArray temp(mShape, layout, mTileSize);
+		ForEach([&temp](const Extents& index, T& value) { temp.mStorage.Data()[temp.offset(index)] = std::move(value); });
+		Swap(temp);
+	}
+
+	const Extents& Shape() const noexcept
+	{
+		return mShape;
+	}
+
+	const Array<T>& Storage() const noexcept
+	{
+		return mStorage;
+	}
+
+	void Swap(MDArray& other) noexcept
+	{
+		mStorage.Swap(other.mStorage);
+		std::swap(mShape, other.mShape);
+		std::swap(mStrides, other.mStrides);
+		std::swap(mLayout, other.mLayout);
+		std::swap(mTileSize, other.mTileSize);
+	}
+
+	size_t TileSize() const noexcept
+	{
+		return mTileSize;
+	}
+
+	// Strided views are only available for row- and column-major storage; a tiled array has
+	// no single stride per dimension and must be Relayout()'d first.
+	View GetView()
+	{
+		checkStrided();
+		return View(mStorage.Data(), mShape, mStrides);
+	}
+
+	ConstView GetView() const
+	{
+		checkStrided();
+		return ConstView(mStorage.Data(), mShape, mStrides);
+	}
+
+private:
+	template <typename Self, typename Function>
+	static void forEach(Self& self, Function& func)
+	{
+		if (self.mLayout != MDLayout::Tiled)
+		{
+			self.GetView().ForEach(func);
+			return;
+		}
+
+		if (self.Count() == 0)
+		{
+			return;
+		}
+
+		// Tiled storage is already blocked, so walking tiles in storage order is cache friendly.
+		Extents tiles = self.tileCounts();
+		Extents tile{};
+		do
+		{
+			Extents index;
+			for (size_t d = 0; d < Rank; ++d)
+			{
+				index[d] = tile[d] * self.mTileSize;
+			}
+			do
+			{
+				func(static_cast<const Extents&>(index), self.mStorage.Data()[self.offset(index)]);
+			} while (self.advanceInTile(index, tile));
+		} while (advanceTile(tile, tiles));
+	}
+
+	static bool advanceTile(Extents& tile, const Extents& tiles) noexcept
+	{
+		for (size_t d = Rank; d-- > 0; )
+		{
+			if (++tile[d] < tiles[d])
+			{
+				return true;
+			}
+			tile[d] = 0;
+		}
+		return false;
+	}
+
+	bool advanceInTile(Extents& index, const Extents& tile) const noexcept
+	{
+		for (size_t d = Rank; d-- > 0; )
+		{
+			size_t limit = std::min((tile[d] + 1) * mTileSize, mShape[d]);
+			if (++index[d] < limit)
+			{
+				return true;
+			}
+			index[d] = tile[d] * mTileSize;
+		}
+		return false;
+	}
+
+	Extents tileCounts() const noexcept
+	{
+		Extents tiles;
+		for (size_t d = 0; d < Rank; ++d)
+		{
+			tiles[d] = (mShape[d] + mTileSize - 1) / mTileSize;
+		}
+		return tiles;
+	}
+
+	size_t tileVolume() const noexcept
+	{
+		size_t result = 1;
+		for (size_t d = 0; d < Rank; ++d)
+		{
+			result *= mTileSize;
+		}
+		return result;
+	}
+
+	void computeStrides() noexcept
+	{
+		size_t stride = 1;
+		if (mLayout == MDLayout::ColumnMajor)
+		{
+			for (size_t d = 0; d < Rank; ++d)
+			{
+				mStrides[d] = stride;
+				stride *= mShape[d];
+			}
+		}
+		else
+		{
+			for (size_t d = Rank; d-- > 0; )
+			{
+				mStrides[d] = stride;
+				stride *= mShape[d];
+			}
+		}
+	}
+
+	size_t storageCount() const noexcept
+	{
+		if (mLayout != MDLayout::Tiled)
+		{
+			return Count();
+		}
+
+		size_t tiles = 1;
+		for (size_t extent : tileCounts())
+		{
+			tiles *= extent;
+		}
+		return Count() == 0 ? 0 : tiles * tileVolume();
+	}
+
+	// Tiled storage places whole tiles back to back in row-major tile order, each tile itself
+	// row-major; edge tiles are padded to the full tile size.
+	size_t offset(const Extents& index) const noexcept
+	{
+		if (mLayout != MDLayout::Tiled)
+		{
+			size_t result = 0;
+			for (size_t d = 0; d < Rank; ++d)
+			{
+				result += index[d] * mStrides[d];
+			}
+			return result;
+		}
+
+		Extents tiles = tileCounts();
+		size_t tileIndex = 0;
+		size_t inTile = 0;
+		for (size_t d = 0; d < Rank; ++d)
+		{
+			tileIndex = tileIndex * tiles[d] + index[d] / mTileSize;
+			inTile = inTile * mTileSize + index[d] % mTileSize;
+		}
+		return tileIndex * tileVolume() + inTile;
+	}
+
+	void checkRange(const Extents& index) const
+	{
+		for (size_t d = 0; d < Rank; ++d)
+		{
+			if (index[d] >= mShape[d])
+			{
+				throw std::out_of_range("MDArray index out of range");
+			}
+		}
+	}
+
+	void checkStrided() const
+	{
+		if (mLayout == MDLayout::Tiled)
+		{
+			throw std::logic_error("MDArray tiled layout has no strided view");
+		}
+	}
+
+private:
+	Array<T> mStorage;
+	Extents mShape;
+	Extents mStrides;
+	MDLayout mLayout;
+	size_t mTileSize;
+};
+
+} // namespace abouttt
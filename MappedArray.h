@@ -0,0 +1,289 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Array.h"
+#include "ArrayFile.h"
+
+namespace abouttt
+{
+
+enum class MappedAdvice
+{
+	Normal,
+	Sequential,
+	Random,
+	WillNeed,
+};
+
+// Read-only view of a file written by ArrayFile::Save, mapped shared so every process mapping
+// the same file reads the same page-cache pages. Opening validates the header only; elements
+// are paged in on first touch unless bPopulate asks the kernel to prefault them.
+template <typename T>
+class MappedArray
+{
+	static_assert(std::is_trivially_copyable_v<T>, "MappedArray reads raw element bytes");
+
+public:
+	using ConstIterator = ArrayIterator<const T>;
+	using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+public:
+	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
+
+public:
+	MappedArray() noexcept
+		: mMapping(nullptr)
+		, mMappingSize(0)
+		, mData(nullptr)
+		, mCount(0)
+	{
+	}
+
+	explicit MappedArray(const char* path, bool bPopulate = false, MappedAdvice advice = MappedAdvice::Normal)
+		: MappedArray()
+	{
+		int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+		if (fd < 0)
+		{
+			throw std::system_error(errno, std::generic_category(), "MappedArray open failed");
+		}
+
+		try
+		{
+			mapFile(fd, bPopulate);
+		}
+		catch (...)
+		{
+			::close(fd);
+			throw;
+		}
+		::close(fd);
+
+		Advise(advice);
+	}
+
+	MappedArray(const MappedArray&) = delete;
+
+	MappedArray(MappedArray&& other) noexcept
+		: mMapping(std::exchange(other.mMapping, nullptr))
+		, mMappingSize(std::exchange(other.mMappingSize, 0))
+		, mData(std::exchange(other.mData, nullptr))
+		, mCount(std::exchange(other.mCount, 0))
+	{
+	}
+
+	~MappedArray()
+	{
+		cleanup();
+	}
+
+public:
+	MappedArray& operator=(const MappedArray&) = delete;
+
+	MappedArray& operator=(MappedArray&& other) noexcept
+	{
+		if (this != &other)
+		{
+			cleanup();
+			mMapping = std::exchange(other.mMapping, nullptr);
+			mMappingSize = std::exchange(other.mMappingSize, 0);
+			mData = std::exchange(other.mData, nullptr);
+			mCount = std::exchange(other.mCount, 0);
+		}
+		return *this;
+	}
+
+	const T& operator[](size_t index) const
+	{
+		checkRange(index);
+		return mData[index];
+	}
+
+public:
+	// Applies a paging hint to the whole mapping. Hints are advisory, so failures are ignored.
+	void Advise(MappedAdvice advice) const noexcept
+	{
+		if (mMapping)
+		{
+			::madvise(mMapping, mMappingSize, adviceFlag(advice));
+		}
+	}
+
+	bool Contains(const T& value) const
+	{
+		return Find(value) != INDEX_NONE;
+	}
+
+	template <typename Predicate>
+	bool ContainsIf(Predicate pred) const
+	{
+		return FindIf(pred) != INDEX_NONE;
+	}
+
+	size_t Count() const noexcept
+	{
+		return mCount;
+	}
+
+	const T* Data() const noexcept
+	{
+		return mData;
+	}
+
+	size_t Find(const T& value) const
+	{
+		const T* it = std::find(mData, mData + mCount, value);
+		return it != mData + mCount ? static_cast<size_t>(it - mData) : INDEX_NONE;
+	}
+
+	template <typename Predicate>
+	size_t FindIf(Predicate pred) const
+	{
+		const T* it = std::find_if(mData, mData + mCount, pred);
+		return it != mData + mCount ? static_cast<size_t>(it - mData) : INDEX_NONE;
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return mCount == 0;
+	}
+
+	bool IsOpen() const noexcept
+	{
+		return mMapping != nullptr;
+	}
+
+	// Reads every mapped page to check the payload checksum recorded by Save.
+	bool VerifyChecksum() const noexcept
+	{
+		const ArrayFile::Header* header = static_cast<const ArrayFile::Header*>(mMapping);
+		return header && ArrayFile::Checksum(mData, sizeof(T) * mCount) == header->Checksum;
+	}
+
+public: // Iterators for range-based loop support.
+	ConstIterator begin() const noexcept
+	{
+		return ConstIterator(mData);
+	}
+
+	ConstIterator end() const noexcept
+	{
+		return ConstIterator(mData + mCount);
+	}
+
+	ConstReverseIterator rbegin() const noexcept
+	{
+		return ConstReverseIterator(end());
+	}
+
+	ConstReverseIterator rend() const noexcept
+	{
+		return ConstReverseIterator(begin());
+	}
+
+private:
+	static int adviceFlag(MappedAdvice advice) noexcept
+	{
+		switch (advice)
+		{
+		case MappedAdvice::Sequential:
+			return MADV_SEQUENTIAL;
+		case MappedAdvice::Random:
+			return MADV_RANDOM;
+		case MappedAdvice::WillNeed:
+			return MADV_WILLNEED;
+		default:
+			return MADV_NORMAL;
+		}
+	}
+
+	void mapFile(int fd, bool bPopulate)
+	{
+		struct stat info;
+		if (::fstat(fd, &info) != 0)
+		{
+			throw std::system_error(errno, std::generic_category(), "MappedArray stat failed");
+		}
+
+		size_t fileSize = static_cast<size_t>(info.st_size);
+		if (fileSize < sizeof(ArrayFile::Header))
+		{
+			throw std::runtime_error("ArrayFile is truncated");
+		}
+
+		int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+		if (bPopulate)
+		{
+			flags |= MAP_POPULATE;
+		}
+#endif
+		void* mapping = ::mmap(nullptr, fileSize, PROT_READ, flags, fd, 0);
+		if (mapping == MAP_FAILED)
+		{
+			throw std::system_error(errno, std::generic_category(), "MappedArray mmap failed");
+		}
+		mMapping = mapping;
+		mMappingSize = fileSize;
+
+		try
+		{
+			const ArrayFile::Header& header = *static_cast<const ArrayFile::Header*>(mapping);
+			size_t count = ArrayFile::CheckHeader<T>(header);
+			if (header.PayloadOffset > fileSize || count > (fileSize - header.PayloadOffset) / sizeof(T))
+			{
+				throw std::runtime_error("ArrayFile is truncated");
+			}
+
+			mData = reinterpret_cast<const T*>(static_cast<const std::byte*>(mapping) + header.PayloadOffset);
+			mCount = count;
+		}
+		catch (...)
+		{
+			cleanup();
+			throw;
+		}
+	}
+
+	void checkRange(size_t index) const
+	{
+		if (index >= mCount)
+		{
+			throw std::out_of_range("MappedArray index out of range");
+		}
+	}
+
+	void cleanup() noexcept
+	{
+		if (mMapping)
+		{
+			::munmap(mMapping, mMappingSize);
+			mMapping = nullptr;
+			mMappingSize = 0;
+			mData = nullptr;
+			mCount = 0;
+		}
+	}
+
+private:
+	void* mMapping;
+	size_t mMappingSize;
+	const T* mData;
+	size_t mCount;
+};
+
+} // namespace abouttt
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+class PackedIntArray
+{
+public:
+	using Word = uint64_t;
+
+public:
+	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
+	static constexpr size_t WORD_BITS = 64;
+
+public:
+	PackedIntArray() noexcept
+		: PackedIntArray(1)
+	{
+	}
+
+	explicit PackedIntArray(size_t bitWidth)
+		: mWords()
+		, mCount(0)
+		, mBitWidth(checkBitWidth(bitWidth))
+	{
+	}
+
+	PackedIntArray(size_t bitWidth, size_t count)
+		: PackedIntArray(bitWidth)
+	{
+		Resize(count);
+	}
+
+public:
+	uint64_t operator[](size_t index) const
+	{
+		return Get(index);
+	}
+
+	bool operator==(const PackedIntArray& other) const
+	{
+		return mBitWidth == other.mBitWidth && mCount == other.mCount && mWords == other.mWords;
+	}
+
+public:
+	template <typename T>
+	static PackedIntArray FromArray(const Array<T>& source)
+	{
+		static_assert(std::is_integral_v<T>, "PackedIntArray packs integral values");
+
+		uint64_t maxValue = 0;
+		for (const T& value : source)
+		{
+			maxValue |= static_cast<uint64_t>(static_cast<std::make_unsigned_t<T>>(value));
+		}
+
+		PackedIntArray result(std::max<size_t>(1, std::bit_width(maxValue)));
+		result.Reserve(source.Count());
+		for (const T& value : source)
+		{
+			result.Add(static_cast<uint64_t>(static_cast<std::make_unsigned_t<T>>(value)));
+		}
+		return result;
+	}
+
+	void Add(uint64_t value)
+	{
+		checkValue(value);
+		mWords.Resize(wordsFor(mCount + 1), 0);
+		store(mCount, value);
+		++mCount;
+	}
+
+	size_t BitWidth() const noexcept
+	{
+		return mBitWidth;
+	}
+
+	size_t Capacity() const noexcept
+	{
+		return mWords.Capacity() * WORD_BITS / mBitWidth;
+	}
+
+	void Clear() noexcept
+	{
+		mWords.Clear();
+		mCount = 0;
+	}
+
+	size_t Count() const noexcept
+	{
+		return mCount;
+	}
+
+	uint64_t Get(size_t index) const
+	{
+		checkRange(index);
+		return load(index);
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return mCount == 0;
+	}
+
+	void Reserve(size_t newCapacity)
+	{
+		mWords.Reserve(wordsFor(newCapacity));
+	}
+
+	void Resize(size_t newCount)
+	{
+		mWords.Resize(wordsFor(newCount), 0);
+		mCount = newCount;
+		trimTail();
+	}
+
+	void Set(size_t index, uint64_t value)
+	{
+		checkRange(index);
+		checkValue(value);
+		store(index, value);
+	}
+
+	void Shrink()
+	{
+		mWords.Shrink();
+	}
+
+	void Swap(PackedIntArray& other) noexcept
+	{
+		mWords.Swap(other.mWords);
+		std::swap(mCount, other.mCount);
+		std::swap(mBitWidth, other.mBitWidth);
+	}
+
+	// Decodes sequentially with a running bit offset, avoiding the per-element multiply and
+	// division of Get().
+	template <typename T>
+	void Unpack(Array<T>& target) const
+	{
+		static_assert(std::is_integral_v<T>, "PackedIntArray unpacks into integral values");
+
+		target.Resize(mCount);
+		T* out = target.Data();
+		const Word* words = mWords.Data();
+		const Word mask = valueMask();
+		size_t bit = 0;
+
+		for (size_t i = 0; i < mCount; ++i, bit += mBitWidth)
+		{
+			size_t wordIndex = bit / WORD_BITS;
+			size_t shift = bit % WORD_BITS;
+			Word value = words[wordIndex] >> shift;
+			if (shift + mBitWidth > WORD_BITS)
+			{
+				value |= words[wordIndex + 1] << (WORD_BITS - shift);
+			}
+			out[i] = static_cast<T>(value & mask);
+		}
+	}
+
+	void Widen(size_t newBitWidth)
+	{
+		checkBitWidth(newBitWidth);
+		if (newBitWidth <= mBitWidth)
+		{
+			return;
+		}
+
+		PackedIntArray temp(newBitWidth);
+		temp.Reserve(mCount);
+		for (size_t i = 0; i < mCount; ++i)
+		{
+			temp.Add(load(i));
+		}
+		Swap(temp);
+	}
+
+private:
+	static size_t checkBitWidth(size_t bitWidth)
+	{
+		if (bitWidth == 0 || bitWidth > WORD_BITS)
+		{
+			throw std::out_of_range("PackedIntArray bit width out of range");
+		}
+		return bitWidth;
+	}
+
+	size_t wordsFor(size_t count) const noexcept
+	{
+		return (count * mBitWidth + WORD_BITS - 1) / WORD_BITS;
+	}
+
+	Word valueMask() const noexcept
+	{
+		return mBitWidth == WORD_BITS ? ~Word(0) : (Word(1) << mBitWidth) - 1;
+	}
+
+	uint64_t load(size_t index) const noexcept
+	{
+		const Word* words = mWords.Data();
+		size_t bit = index * mBitWidth;
+		size_t wordIndex = bit / WORD_BITS;
+		size_t shift = bit % WORD_BITS;
+
+		Word value = words[wordIndex] >> shift;
+		if (shift + mBitWidth > WORD_BITS)
+		{
+			value |= words[wordIndex + 1] << (WORD_BITS - shift);
+		}
+		return value & valueMask();
+	}
+
+	void store(size_t index, uint64_t value) noexcept
+	{
+		Word* words = mWords.Data();
+		const Word mask = valueMask();
+		size_t bit = index * mBitWidth;
+		size_t wordIndex = bit / WORD_BITS;
+		size_t shift = bit % WORD_BITS;
+
+		words[wordIndex] = (words[wordIndex] & ~(mask << shift)) | (value << shift);
+		if (shift + mBitWidth > WORD_BITS)
+		{
+			size_t spill = WORD_BITS - shift;
+			words[wordIndex + 1] = (words[wordIndex + 1] & ~(mask >> spill)) | (value >> spill);
+		}
+	}
+
+	// Bits past the last element are kept clear so growth and comparison need no masking.
+	void trimTail() noexcept
+	{
+		size_t tail = (mCount * mBitWidth) % WORD_BITS;
+		if (tail != 0)
+		{
+			mWords.Data()[mWords.Count() - 1] &= (Word(1) << tail) - 1;
+		}
+	}
+
+	void checkRange(size_t index) const
+	{
+		if (index >= mCount)
+		{
+			throw std::out_of_range("PackedIntArray index out of range");
+		}
+	}
+
+	void checkValue(uint64_t value) const
+	{
+		if ((value & ~valueMask()) != 0)
+		{
+			throw std::out_of_range("PackedIntArray value exceeds bit width");
+		}
+	}
+
+private:
+	Array<Word> mWords;
+	size_t mCount;
+	size_t mBitWidth;
+};
+
+} // namespace abouttt
@@ -0,0 +1,489 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Array.h"
+#include "ArrayFile.h"
+
+namespace abouttt
+{
+
+// Array whose storage is a shared mapping of a file in ArrayFile format, so it can be reopened
+// here or read by ArrayFile::Load and MappedArray. Growth extends the file with ftruncate and
+// the mapping with mremap instead of copying into a new block.
+//
+// The on-disk header only changes in Flush(), after the payload it describes has been synced,
+// so a crash leaves the file as of the last checkpoint: elements appended since then are simply
+// not counted. In-place edits of already-flushed elements are not atomic; a crash mid-edit can
+// surface as a payload checksum mismatch.
+//
+// The payload checksum is kept as a running state, so a Flush after appends hashes only the
+// appended bytes. Mutable element access (non-const operator[], Data(), iterators) and
+// removals restart it from the first element, making the next Flush hash the whole payload;
+// read through a const reference to keep checkpoints cheap.
+template <typename T>
+class PersistentArray
+{
+	static_assert(std::is_trivially_copyable_v<T>, "PersistentArray stores raw element bytes");
+
+public:
+	using Iterator = ArrayIterator<T>;
+	using ConstIterator = ArrayIterator<const T>;
+	using ReverseIterator = std::reverse_iterator<Iterator>;
+	using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+public:
+	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
+
+public:
+	PersistentArray() noexcept
+		: mFd(-1)
+		, mMapping(nullptr)
+		, mMappingSize(0)
+		, mCount(0)
+		, mChecksum()
+	{
+	}
+
+	// Opens path, creating an empty array file if it does not exist or is empty.
+	explicit PersistentArray(const char* path)
+		: PersistentArray()
+	{
+		mFd = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+		if (mFd < 0)
+		{
+			throw std::system_error(errno, std::generic_category(), "PersistentArray open failed");
+		}
+
+		try
+		{
+			openFile();
+		}
+		catch (...)
+		{
+			cleanup();
+			throw;
+		}
+	}
+
+	PersistentArray(const PersistentArray&) = delete;
+
+	PersistentArray(PersistentArray&& other) noexcept
+		: mFd(std::exchange(other.mFd, -1))
+		, mMapping(std::exchange(other.mMapping, nullptr))
+		, mMappingSize(std::exchange(other.mMappingSize, 0))
+		, mCount(std::exchange(other.mCount, 0))
+		, mChecksum(std::exchange(other.mChecksum, {}))
+	{
+	}
+
+	// Checkpoints on close; failures cannot be reported here, so call Flush() first when the
+	// result matters.
+	~PersistentArray()
+	{
+		try
+		{
+			Flush();
+		}
+		catch (...)
+		{
+		}
+		cleanup();
+	}
+
+public:
+	PersistentArray& operator=(const PersistentArray&) = delete;
+
+	PersistentArray& operator=(PersistentArray&& other) noexcept
+	{
+		if (this != &other)
+		{
+			PersistentArray temp(std::move(other));
+			Swap(temp);
+		}
+		return *this;
+	}
+
+	T& operator[](size_t index)
+	{
+		checkRange(index);
+		invalidateChecksum(index);
+		return elements()[index];
+	}
+
+	const T& operator[](size_t index) const
+	{
+		checkRange(index);
+		return Data()[index];
+	}
+
+public:
+	void Add(const T& value)
+	{
+		ensureCapacity(mCount + 1);
+		elements()[mCount] = value;
+		++mCount;
+	}
+
+	void Append(const T* ptr, size_t count)
+	{
+		ensureCapacity(mCount + count);
+		std::copy_n(ptr, count, elements() + mCount);
+		mCount += count;
+	}
+
+	size_t Capacity() const noexcept
+	{
+		return mMapping ? (mMappingSize - PAYLOAD_OFFSET) / sizeof(T) : 0;
+	}
+
+	void Clear() noexcept
+	{
+		mCount = 0;
+		invalidateChecksum(0);
+	}
+
+	bool Contains(const T& value) const
+	{
+		return Find(value) != INDEX_NONE;
+	}
+
+	size_t Count() const noexcept
+	{
+		return mCount;
+	}
+
+	T* Data() noexcept
+	{
+		invalidateChecksum(0);
+		return elements();
+	}
+
+	const T* Data() const noexcept
+	{
+		return mMapping ? reinterpret_cast<const T*>(mMapping + PAYLOAD_OFFSET) : nullptr;
+	}
+
+	size_t Find(const T& value) const
+	{
+		const T* it = std::find(Data(), Data() + mCount, value);
+		return it != Data() + mCount ? static_cast<size_t>(it - Data()) : INDEX_NONE;
+	}
+
+	template <typename Predicate>
+	size_t FindIf(Predicate pred) const
+	{
+		const T* it = std::find_if(Data(), Data() + mCount, pred);
+		return it != Data() + mCount ? static_cast<size_t>(it - Data()) : INDEX_NONE;
+	}
+
+	// Checkpoint: syncs the payload, then publishes the new count and checksums in the header
+	// and syncs that. The header fits in the first disk sector, and its own checksum rejects a
+	// torn write.
+	void Flush()
+	{
+		if (!mMapping)
+		{
+			return;
+		}
+
+		size_t payloadSize = sizeof(T) * mCount;
+		syncRange(PAYLOAD_OFFSET + payloadSize);
+
+		const std::byte* payload = mMapping + PAYLOAD_OFFSET;
+		size_t consumed = mChecksum.ConsumedBytes();
+		consumed += mChecksum.Consume(payload + consumed, payloadSize - consumed);
+		uint64_t checksum = mChecksum.Finish(payload + consumed, payloadSize - consumed);
+
+		ArrayFile::Header header = ArrayFile::MakeHeaderWithChecksum<T>(mCount, checksum);
+		std::memcpy(mMapping, &header, sizeof(header));
+		syncRange(sizeof(header));
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return mCount == 0;
+	}
+
+	bool IsOpen() const noexcept
+	{
+		return mMapping != nullptr;
+	}
+
+	void RemoveAt(size_t index)
+	{
+		checkRange(index);
+		invalidateChecksum(index);
+		std::copy(elements() + index + 1, elements() + mCount, elements() + index);
+		--mCount;
+	}
+
+	void Reserve(size_t newCapacity)
+	{
+		if (newCapacity > Capacity())
+		{
+			remap(newCapacity);
+		}
+	}
+
+	void Resize(size_t newCount, const T& value = T())
+	{
+		if (newCount > mCount)
+		{
+			ensureCapacity(newCount);
+			std::fill_n(elements() + mCount, newCount - mCount, value);
+		}
+		else
+		{
+			invalidateChecksum(newCount);
+		}
+		mCount = newCount;
+	}
+
+	// Truncates the file to the pages the current elements need.
+	void Shrink()
+	{
+		if (mMapping && fileSizeFor(mCount) < mMappingSize)
+		{
+			remap(mCount);
+		}
+	}
+
+	void Swap(PersistentArray& other) noexcept
+	{
+		std::swap(mFd, other.mFd);
+		std::swap(mMapping, other.mMapping);
+		std::swap(mMappingSize, other.mMappingSize);
+		std::swap(mCount, other.mCount);
+		std::swap(mChecksum, other.mChecksum);
+	}
+
+public: // Iterators for range-based loop support.
+	Iterator begin() noexcept
+	{
+		return Iterator(Data());
+	}
+
+	ConstIterator begin() const noexcept
+	{
+		return ConstIterator(Data());
+	}
+
+	Iterator end() noexcept
+	{
+		return Iterator(Data() + mCount);
+	}
+
+	ConstIterator end() const noexcept
+	{
+		return ConstIterator(Data() + mCount);
+	}
+
+	ReverseIterator rbegin() noexcept
+	{
+		return ReverseIterator(end());
+	}
+
+	ConstReverseIterator rbegin() const noexcept
+	{
+		return ConstReverseIterator(end());
+	}
+
+	ReverseIterator rend() noexcept
+	{
+		return ReverseIterator(begin());
+	}
+
+	ConstReverseIterator rend() const noexcept
+	{
+		return ConstReverseIterator(begin());
+	}
+
+private:
+	static constexpr size_t PAYLOAD_OFFSET = ArrayFile::PayloadOffset<T>();
+
+	static size_t fileSizeFor(size_t capacity) noexcept
+	{
+		size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+		size_t bytes = PAYLOAD_OFFSET + sizeof(T) * capacity;
+		return (bytes + pageSize - 1) / pageSize * pageSize;
+	}
+
+	void openFile()
+	{
+		struct stat info;
+		if (::fstat(mFd, &info) != 0)
+		{
+			throw std::system_error(errno, std::generic_category(), "PersistentArray stat failed");
+		}
+
+		size_t fileSize = static_cast<size_t>(info.st_size);
+		if (fileSize == 0)
+		{
+			remap(0);
+			Flush();
+			return;
+		}
+		if (fileSize < sizeof(ArrayFile::Header))
+		{
+			throw std::runtime_error("ArrayFile is truncated");
+		}
+
+		mMapping = mapRange(fileSize);
+		mMappingSize = fileSize;
+		const ArrayFile::Header& header = *reinterpret_cast<const ArrayFile::Header*>(mMapping);
+		size_t count = ArrayFile::CheckHeader<T>(header);
+		if (count > Capacity())
+		{
+			throw std::runtime_error("ArrayFile is truncated");
+		}
+		mCount = count;
+	}
+
+	std::byte* mapRange(size_t size)
+	{
+		void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+		if (mapping == MAP_FAILED)
+		{
+			throw std::system_error(errno, std::generic_category(), "PersistentArray mmap failed");
+		}
+		return static_cast<std::byte*>(mapping);
+	}
+
+	T* elements() noexcept
+	{
+		return mMapping ? reinterpret_cast<T*>(mMapping + PAYLOAD_OFFSET) : nullptr;
+	}
+
+	// Called before elements from index on may change; the running checksum can only be
+	// extended, so touching anything it already covers restarts it.
+	void invalidateChecksum(size_t index) noexcept
+	{
+		if (sizeof(T) * index < mChecksum.ConsumedBytes())
+		{
+			mChecksum = ArrayFile::ChecksumState();
+		}
+	}
+
+	void ensureCapacity(size_t minCapacity)
+	{
+		size_t capacity = Capacity();
+		if (minCapacity > capacity)
+		{
+			size_t grow = capacity + (capacity >> 1); // Grow by 1.5x
+			remap(std::max(minCapacity, grow));
+		}
+	}
+
+	// Resizes the file and the mapping together. The file is extended before the mapping grows
+	// and only cut after it shrinks, so no mapped page is ever past end-of-file. Before a cut,
+	// a checkpoint makes the on-disk count fit the shorter file; the last flushed count may
+	// be larger, and a file whose header outruns its payload cannot be reopened.
+	void remap(size_t newCapacity)
+	{
+		size_t oldSize = mMappingSize;
+		size_t newSize = fileSizeFor(newCapacity);
+		if (newSize > oldSize)
+		{
+			truncateFile(newSize);
+		}
+		else if (newSize < oldSize)
+		{
+			Flush();
+		}
+
+		if (!mMapping)
+		{
+			mMapping = mapRange(newSize);
+			mMappingSize = newSize;
+		}
+		else if (newSize != oldSize)
+		{
+#ifdef MREMAP_MAYMOVE
+			void* mapping = ::mremap(mMapping, oldSize, newSize, MREMAP_MAYMOVE);
+			if (mapping == MAP_FAILED)
+			{
+				throw std::system_error(errno, std::generic_category(), "PersistentArray mremap failed");
+			}
+			mMapping = static_cast<std::byte*>(mapping);
+			mMappingSize = newSize;
+#else
+			// Map the new size before dropping the old mapping, so a failure leaves it intact.
+			std::byte* mapping = mapRange(newSize);
+			::munmap(mMapping, oldSize);
+			mMapping = mapping;
+			mMappingSize = newSize;
+#endif
+		}
+
+		if (newSize < oldSize)
+		{
+			truncateFile(newSize);
+		}
+	}
+
+	void truncateFile(size_t size)
+	{
+		if (::ftruncate(mFd, static_cast<off_t>(size)) != 0)
+		{
+			throw std::system_error(errno, std::generic_category(), "PersistentArray ftruncate failed");
+		}
+	}
+
+	void syncRange(size_t size)
+	{
+		if (::msync(mMapping, size, MS_SYNC) != 0)
+		{
+			throw std::system_error(errno, std::generic_category(), "PersistentArray msync failed");
+		}
+	}
+
+	void checkRange(size_t index) const
+	{
+		if (index >= mCount)
+		{
+			throw std::out_of_range("PersistentArray index out of range");
+		}
+	}
+
+	void cleanup() noexcept
+	{
+		if (mMapping)
+		{
+			::munmap(mMapping, mMappingSize);
+			mMapping = nullptr;
+			mMappingSize = 0;
+		}
+		if (mFd >= 0)
+		{
+			::close(mFd);
+			mFd = -1;
+		}
+		mCount = 0;
+		mChecksum = ArrayFile::ChecksumState();
+	}
+
+private:
+	int mFd;
+	std::byte* mMapping;
+	size_t mMappingSize;
+	size_t mCount;
+	ArrayFile::ChecksumState mChecksum;
+};
+
+} // namespace abouttt
@@ -0,0 +1,322 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+// Stores each concrete type in its own contiguous Array, so a visitor called through ForEach is
+// statically dispatched per segment: no pointer chase or indirect call per element.
+//
+// Elements are addressed by generational handles. Removal swaps the last element of the
+// segment into the hole and patches its slot, so handles to other elements stay valid, and a
+// handle to a removed element is rejected rather than aliasing whatever reuses its slot.
+template <typename... Types>
+class PolyArray
+{
+	static_assert(sizeof...(Types) > 0, "PolyArray requires at least one type");
+	static_assert(sizeof...(Types) < 255, "PolyArray type index must fit in a byte");
+
+public:
+	struct Handle
+	{
+		uint32_t Index = std::numeric_limits<uint32_t>::max();
+		uint32_t Generation = 0;
+
+		bool operator==(const Handle& other) const = default;
+	};
+
+public:
+	static constexpr size_t TYPE_COUNT = sizeof...(Types);
+
+public:
+	PolyArray() noexcept
+		: mSegments()
+		, mOwners()
+		, mSlots()
+		, mFreeHead(SLOT_NONE)
+	{
+	}
+
+public:
+	template <typename T>
+	Handle Add(T&& value)
+	{
+		return Emplace<std::remove_cvref_t<T>>(std::forward<T>(value));
+	}
+
+	void Clear() noexcept
+	{
+		std::apply([](auto&... segments) { (segments.Clear(), ...); }, mSegments);
+		for (Array<uint32_t>& owners : mOwners)
+		{
+			owners.Clear();
+		}
+		// Slots are released rather than dropped so outstanding handles stay rejected.
+		for (uint32_t index = 0; index < mSlots.Count(); ++index)
+		{
+			if (mSlots.Data()[index].Type != TYPE_FREE)
+			{
+				freeSlot(index);
+			}
+		}
+	}
+
+	bool Contains(Handle handle) const noexcept
+	{
+		return handle.Index < mSlots.Count()
+			&& mSlots.Data()[handle.Index].Type != TYPE_FREE
+			&& mSlots.Data()[handle.Index].Generation == handle.Generation;
+	}
+
+	size_t Count() const noexcept
+	{
+		return std::apply([](const auto&... segments) { return (segments.Count() + ...); }, mSegments);
+	}
+
+	template <typename T>
+	size_t Count() const noexcept
+	{
+		return std::get<typeIndex<T>()>(mSegments).Count();
+	}
+
+	template <typename T, typename... Args>
+	Handle Emplace(Args&&... args)
+	{
+		constexpr size_t type = typeIndex<T>();
+		Array<T>& segment = std::get<type>(mSegments);
+		if (segment.Count() >= SLOT_NONE)
+		{
+			throw std::length_error("PolyArray segment is full");
+		}
+
+		uint32_t index = allocateSlot();
+		try
+		{
+			segment.Emplace(std::forward<Args>(args)...);
+			mOwners[type].Add(index);
+		}
+		catch (...)
+		{
+			if (mOwners[type].Count() < segment.Count())
+			{
+				segment.RemoveAt(segment.Count() - 1);
+			}
+			freeSlot(index);
+			throw;
+		}
+
+		Slot& slot = mSlots.Data()[index];
+		slot.Position = static_cast<uint32_t>(segment.Count() - 1);
+		slot.Type = static_cast<uint8_t>(type);
+		return Handle{ index, slot.Generation };
+	}
+
+	// Visits every element segment by segment, in the order Types are listed.
+	template <typename Visitor>
+	void ForEach(Visitor visitor)
+	{
+		std::apply([&visitor](auto&... segments) { (forEachIn(segments, visitor), ...); }, mSegments);
+	}
+
+	template <typename Visitor>
+	void ForEach(Visitor visitor) const
+	{
+		std::apply([&visitor](const auto&... segments) { (forEachIn(segments, visitor), ...); }, mSegments);
+	}
+
+	template <typename T>
+	T* Get(Handle handle) noexcept
+	{
+		if (!Contains(handle) || mSlots.Data()[handle.Index].Type != typeIndex<T>())
+		{
+			return nullptr;
+		}
+		return std::get<typeIndex<T>()>(mSegments).Data() + mSlots.Data()[handle.Index].Position;
+	}
+
+	template <typename T>
+	const T* Get(Handle handle) const noexcept
+	{
+		return const_cast<PolyArray*>(this)->template Get<T>(handle);
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return Count() == 0;
+	}
+
+	bool Remove(Handle handle)
+	{
+		if (!Contains(handle))
+		{
+			return false;
+		}
+
+		const Slot& slot = mSlots.Data()[handle.Index];
+		removeAt(slot.Type, slot.Position, std::index_sequence_for<Types...>());
+		freeSlot(handle.Index);
+		return true;
+	}
+
+	template <typename T>
+	void Reserve(size_t capacity)
+	{
+		std::get<typeIndex<T>()>(mSegments).Reserve(capacity);
+		mOwners[typeIndex<T>()].Reserve(capacity);
+	}
+
+	template <typename T>
+	std::span<T> Segment() noexcept
+	{
+		Array<T>& segment = std::get<typeIndex<T>()>(mSegments);
+		return std::span<T>(segment.Data(), segment.Count());
+	}
+
+	template <typename T>
+	std::span<const T> Segment() const noexcept
+	{
+		const Array<T>& segment = std::get<typeIndex<T>()>(mSegments);
+		return std::span<const T>(segment.Data(), segment.Count());
+	}
+
+	void Shrink()
+	{
+		std::apply([](auto&... segments) { (segments.Shrink(), ...); }, mSegments);
+		for (Array<uint32_t>& owners : mOwners)
+		{
+			owners.Shrink();
+		}
+	}
+
+	// Calls visitor with the element behind handle as its concrete type.
+	template <typename Visitor>
+	void Visit(Handle handle, Visitor visitor)
+	{
+		if (!Contains(handle))
+		{
+			throw std::out_of_range("PolyArray handle is not valid");
+		}
+		const Slot& slot = mSlots.Data()[handle.Index];
+		visitAt(*this, slot.Type, slot.Position, visitor, std::index_sequence_for<Types...>());
+	}
+
+	template <typename Visitor>
+	void Visit(Handle handle, Visitor visitor) const
+	{
+		if (!Contains(handle))
+		{
+			throw std::out_of_range("PolyArray handle is not valid");
+		}
+		const Slot& slot = mSlots.Data()[handle.Index];
+		visitAt(*this, slot.Type, slot.Position, visitor, std::index_sequence_for<Types...>());
+	}
+
+private:
+	// Type is TYPE_FREE while the slot is on the free list, where Position links to the next
+	// free slot. Generation is bumped on every release.
+	struct Slot
+	{
+		uint32_t Position;
+		uint32_t Generation;
+		uint8_t Type;
+	};
+
+	static constexpr uint32_t SLOT_NONE = std::numeric_limits<uint32_t>::max();
+	static constexpr uint8_t TYPE_FREE = std::numeric_limits<uint8_t>::max();
+
+	template <typename T>
+	static constexpr size_t typeIndex() noexcept
+	{
+		constexpr std::array<bool, TYPE_COUNT> matches{ std::is_same_v<T, Types>... };
+		static_assert((std::is_same_v<T, Types> + ...) == 1, "PolyArray does not store this type");
+
+		size_t index = 0;
+		while (!matches[index])
+		{
+			++index;
+		}
+		return index;
+	}
+
+	template <typename Segment, typename Visitor>
+	static void forEachIn(Segment& segment, Visitor& visitor)
+	{
+		for (auto& element : segment)
+		{
+			visitor(element);
+		}
+	}
+
+	template <typename Self, typename Visitor, size_t... Is>
+	static void visitAt(Self& self, size_t type, size_t position, Visitor& visitor, std::index_sequence<Is...>)
+	{
+		((type == Is ? (visitor(std::get<Is>(self.mSegments).Data()[position]), true) : false) || ...);
+	}
+
+	template <size_t... Is>
+	void removeAt(size_t type, size_t position, std::index_sequence<Is...>)
+	{
+		((type == Is ? (removeFrom<Is>(position), true) : false) || ...);
+	}
+
+	template <size_t Type>
+	void removeFrom(size_t position)
+	{
+		auto& segment = std::get<Type>(mSegments);
+		Array<uint32_t>& owners = mOwners[Type];
+		size_t last = segment.Count() - 1;
+
+		if (position != last)
+		{
+			segment.Data()[position] = std::move(segment.Data()[last]);
+			owners.Data()[position] = owners.Data()[last];
+			mSlots.Data()[owners.Data()[position]].Position = static_cast<uint32_t>(position);
+		}
+		segment.RemoveAt(last);
+		owners.RemoveAt(last);
+	}
+
+	uint32_t allocateSlot()
+	{
+		if (mFreeHead != SLOT_NONE)
+		{
+			uint32_t index = mFreeHead;
+			mFreeHead = mSlots.Data()[index].Position;
+			return index;
+		}
+		if (mSlots.Count() >= SLOT_NONE)
+		{
+			throw std::length_error("PolyArray handle space exhausted");
+		}
+		mSlots.Add(Slot{ 0, 0, TYPE_FREE });
+		return static_cast<uint32_t>(mSlots.Count() - 1);
+	}
+
+	void freeSlot(uint32_t index) noexcept
+	{
+		Slot& slot = mSlots.Data()[index];
+		slot.Position = mFreeHead;
+		slot.Type = TYPE_FREE;
+		++slot.Generation;
+		mFreeHead = index;
+	}
+
+private:
+	std::tuple<Array<Types>...> mSegments;
+	std::array<Array<uint32_t>, TYPE_COUNT> mOwners;
+	Array<Slot> mSlots;
+	uint32_t mFreeHead;
+};
+
+} // namespace abouttt
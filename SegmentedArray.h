@@ -0,0 +1,446 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace abouttt
+{
+
+template <typename T>
+class SegmentedArrayIterator;
+
+template <typename T>
+class SegmentedArray
+{
+public:
+	using Iterator = SegmentedArrayIterator<T>;
+	using ConstIterator = SegmentedArrayIterator<const T>;
+	using ReverseIterator = std::reverse_iterator<Iterator>;
+	using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+public:
+	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
+	static constexpr size_t FIRST_SEGMENT_SHIFT = 4;
+	static constexpr size_t FIRST_SEGMENT_SIZE = size_t(1) << FIRST_SEGMENT_SHIFT;
+	static constexpr size_t MAX_SEGMENTS = std::numeric_limits<size_t>::digits - FIRST_SEGMENT_SHIFT;
+
+public:
+	SegmentedArray() noexcept
+		: mSegments()
+		, mCount(0)
+		, mSegmentCount(0)
+	{
+	}
+
+	SegmentedArray(std::initializer_list<T> ilist)
+		: SegmentedArray()
+	{
+		for (const T& value : ilist)
+		{
+			Add(value);
+		}
+	}
+
+	SegmentedArray(const SegmentedArray& other)
+		: SegmentedArray()
+	{
+		Reserve(other.mCount);
+		for (const T& value : other)
+		{
+			Add(value);
+		}
+	}
+
+	SegmentedArray(SegmentedArray&& other) noexcept
+		: SegmentedArray()
+	{
+		Swap(other);
+	}
+
+	~SegmentedArray()
+	{
+		cleanup();
+	}
+
+public:
+	SegmentedArray& operator=(const SegmentedArray& other)
+	{
+		if (this != &other)
+		{
+			SegmentedArray temp(other);
+			Swap(temp);
+		}
+		return *this;
+	}
+
+	SegmentedArray& operator=(SegmentedArray&& other) noexcept
+	{
+		if (this != &other)
+		{
+			cleanup();
+			Swap(other);
+		}
+		return *this;
+	}
+
+	T& operator[](size_t index)
+	{
+		checkRange(index);
+		return *locate(mSegments, index);
+	}
+
+	const T& operator[](size_t index) const
+	{
+		checkRange(index);
+		return *locate(mSegments, index);
+	}
+
+public:
+	void Add(const T& value)
+	{
+		Emplace(value);
+	}
+
+	void Add(T&& value)
+	{
+		Emplace(std::move(value));
+	}
+
+	size_t Capacity() const noexcept
+	{
+		return segmentStart(mSegmentCount);
+	}
+
+	void Clear() noexcept
+	{
+		for (size_t i = mCount; i-- > 0; )
+		{
+			std::destroy_at(locate(mSegments, i));
+		}
+		mCount = 0;
+	}
+
+	bool Contains(const T& value) const
+	{
+		return Find(value) != INDEX_NONE;
+	}
+
+	size_t Count() const noexcept
+	{
+		return mCount;
+	}
+
+	// Existing elements are never moved, so references stay valid until they are removed.
+	template <typename... Args>
+	T& Emplace(Args&&... args)
+	{
+		if (mCount == Capacity())
+		{
+			addSegment();
+		}
+
+		T* slot = locate(mSegments, mCount);
+		std::construct_at(slot, std::forward<Args>(args)...);
+		++mCount;
+
+		return *slot;
+	}
+
+	size_t Find(const T& value) const
+	{
+		return FindIf([&value](const T& element) { return element == value; });
+	}
+
+	template <typename Predicate>
+	size_t FindIf(Predicate pred) const
+	{
+		for (size_t segment = 0, index = 0; index < mCount; ++segment)
+		{
+			const T* data = mSegments[segment];
+			size_t count = std::min(segmentSize(segment), mCount - index);
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (pred(data[i]))
+				{
+					return index + i;
+				}
+			}
+			index += count;
+		}
+		return INDEX_NONE;
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return mCount == 0;
+	}
+
+	void RemoveLast()
+	{
+		checkRange(0);
+		--mCount;
+		std::destroy_at(locate(mSegments, mCount));
+	}
+
+	void Reserve(size_t newCapacity)
+	{
+		while (Capacity() < newCapacity)
+		{
+			addSegment();
+		}
+	}
+
+	size_t SegmentCount() const noexcept
+	{
+		return mSegmentCount;
+	}
+
+	void Shrink()
+	{
+		while (mSegmentCount > 0 && segmentStart(mSegmentCount - 1) >= mCount)
+		{
+			--mSegmentCount;
+			::operator delete(mSegments[mSegmentCount]);
+			mSegments[mSegmentCount] = nullptr;
+		}
+	}
+
+	void Swap(SegmentedArray& other) noexcept
+	{
+		std::swap(mSegments, other.mSegments);
+		std::swap(mCount, other.mCount);
+		std::swap(mSegmentCount, other.mSegmentCount);
+	}
+
+public: // Iterators for range-based loop support.
+	Iterator begin() noexcept
+	{
+		return Iterator(mSegments, 0);
+	}
+
+	ConstIterator begin() const noexcept
+	{
+		return ConstIterator(mSegments, 0);
+	}
+
+	Iterator end() noexcept
+	{
+		return Iterator(mSegments, mCount);
+	}
+
+	ConstIterator end() const noexcept
+	{
+		return ConstIterator(mSegments, mCount);
+	}
+
+	ReverseIterator rbegin() noexcept
+	{
+		return ReverseIterator(end());
+	}
+
+	ConstReverseIterator rbegin() const noexcept
+	{
+		return ConstReverseIterator(end());
+	}
+
+	ReverseIterator rend() noexcept
+	{
+		return ReverseIterator(begin());
+	}
+
+	ConstReverseIterator rend() const noexcept
+	{
+		return ConstReverseIterator(begin());
+	}
+
+private:
+	friend class SegmentedArrayIterator<T>;
+	friend class SegmentedArrayIterator<const T>;
+
+	static constexpr size_t segmentSize(size_t segment) noexcept
+	{
+		return FIRST_SEGMENT_SIZE << segment;
+	}
+
+	static constexpr size_t segmentStart(size_t segment) noexcept
+	{
+		return (FIRST_SEGMENT_SIZE << segment) - FIRST_SEGMENT_SIZE;
+	}
+
+	// Segment k holds indices [B * (2^k - 1), B * (2^(k+1) - 1)), so the highest set bit
+	// of index + B selects the segment.
+	template <typename U>
+	static U* locate(U* const* segments, size_t index) noexcept
+	{
+		size_t biased = index + FIRST_SEGMENT_SIZE;
+		size_t highBit = static_cast<size_t>(std::bit_width(biased)) - 1;
+		return segments[highBit - FIRST_SEGMENT_SHIFT] + (biased - (size_t(1) << highBit));
+	}
+
+	void checkRange(size_t index) const
+	{
+		if (index >= mCount)
+		{
+			throw std::out_of_range("SegmentedArray index out of range");
+		}
+	}
+
+	void addSegment()
+	{
+		if (mSegmentCount == MAX_SEGMENTS)
+		{
+			throw std::length_error("SegmentedArray segment limit reached");
+		}
+		mSegments[mSegmentCount] = static_cast<T*>(::operator new(sizeof(T) * segmentSize(mSegmentCount)));
+		++mSegmentCount;
+	}
+
+	void cleanup() noexcept
+	{
+		Clear();
+		for (size_t i = 0; i < mSegmentCount; ++i)
+		{
+			::operator delete(mSegments[i]);
+			mSegments[i] = nullptr;
+		}
+		mSegmentCount = 0;
+	}
+
+private:
+	T* mSegments[MAX_SEGMENTS];
+	size_t mCount;
+	size_t mSegmentCount;
+};
+
+template <typename T>
+class SegmentedArrayIterator
+{
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = std::remove_const_t<T>;
+	using difference_type = ptrdiff_t;
+	using pointer = T*;
+	using reference = T&;
+
+public:
+	SegmentedArrayIterator() noexcept
+		: mSegments(nullptr)
+		, mIndex(0)
+	{
+	}
+
+	SegmentedArrayIterator(T* const* segments, size_t index) noexcept
+		: mSegments(segments)
+		, mIndex(index)
+	{
+	}
+
+	template<typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+	SegmentedArrayIterator(const SegmentedArrayIterator<std::remove_const_t<T>>& other) noexcept
+		: mSegments(other.mSegments)
+		, mIndex(other.mIndex)
+	{
+	}
+
+public:
+	T& operator*() const noexcept
+	{
+		return *SegmentedArray<value_type>::locate(mSegments, mIndex);
+	}
+
+	T* operator->() const noexcept
+	{
+		return SegmentedArray<value_type>::locate(mSegments, mIndex);
+	}
+
+	T& operator[](size_t index) const noexcept
+	{
+		return *SegmentedArray<value_type>::locate(mSegments, mIndex + index);
+	}
+
+	SegmentedArrayIterator& operator++() noexcept
+	{
+		++mIndex;
+		return *this;
+	}
+
+	SegmentedArrayIterator operator++(int) noexcept
+	{
+		SegmentedArrayIterator temp = *this;
+		++mIndex;
+		return temp;
+	}
+
+	SegmentedArrayIterator& operator--() noexcept
+	{
+		--mIndex;
+		return *this;
+	}
+
+	SegmentedArrayIterator operator--(int) noexcept
+	{
+		SegmentedArrayIterator temp = *this;
+		--mIndex;
+		return temp;
+	}
+
+	SegmentedArrayIterator& operator+=(ptrdiff_t n) noexcept
+	{
+		mIndex += n;
+		return *this;
+	}
+
+	SegmentedArrayIterator& operator-=(ptrdiff_t n) noexcept
+	{
+		mIndex -= n;
+		return *this;
+	}
+
+	SegmentedArrayIterator operator+(size_t n) const noexcept
+	{
+		return SegmentedArrayIterator(mSegments, mIndex + n);
+	}
+
+	SegmentedArrayIterator operator-(size_t n) const noexcept
+	{
+		return SegmentedArrayIterator(mSegments, mIndex - n);
+	}
+
+	ptrdiff_t operator-(const SegmentedArrayIterator& other) const noexcept
+	{
+		return static_cast<ptrdiff_t>(mIndex) - static_cast<ptrdiff_t>(other.mIndex);
+	}
+
+	bool operator==(const SegmentedArrayIterator& other) const noexcept
+	{
+		return mIndex == other.mIndex;
+	}
+
+	bool operator!=(const SegmentedArrayIterator& other) const noexcept
+	{
+		return mIndex != other.mIndex;
+	}
+
+	std::strong_ordering operator<=>(const SegmentedArrayIterator& other) const noexcept
+	{
+		return mIndex <=> other.mIndex;
+	}
+
+private:
+	friend class SegmentedArrayIterator<const T>;
+
+	T* const* mSegments;
+	size_t mIndex;
+};
+
+} // namespace abouttt
@@ -0,0 +1,397 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+template <typename... Fields>
+class SoAArray
+{
+	static_assert(sizeof...(Fields) > 0, "SoAArray requires at least one field");
+
+public:
+	template <size_t I>
+	using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+	using Reference = std::tuple<Fields&...>;
+	using ConstReference = std::tuple<const Fields&...>;
+
+public:
+	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
+	static constexpr size_t COLUMN_ALIGNMENT = std::max({ size_t(64), alignof(Fields)... });
+
+public:
+	SoAArray() noexcept
+		: SoAArray(0)
+	{
+	}
+
+	explicit SoAArray(size_t capacity)
+		: mBlock(nullptr)
+		, mColumns()
+		, mCount(0)
+		, mCapacity(0)
+	{
+		reallocate(capacity);
+	}
+
+	SoAArray(const SoAArray& other)
+		: SoAArray(other.mCount)
+	{
+		copyFrom(other, std::index_sequence_for<Fields...>{});
+		mCount = other.mCount;
+	}
+
+	SoAArray(SoAArray&& other) noexcept
+		: mBlock(std::exchange(other.mBlock, nullptr))
+		, mColumns(std::exchange(other.mColumns, {}))
+		, mCount(std::exchange(other.mCount, 0))
+		, mCapacity(std::exchange(other.mCapacity, 0))
+	{
+	}
+
+	~SoAArray()
+	{
+		cleanup();
+	}
+
+public:
+	SoAArray& operator=(const SoAArray& other)
+	{
+		if (this != &other)
+		{
+			SoAArray temp(other);
+			Swap(temp);
+		}
+		return *this;
+	}
+
+	SoAArray& operator=(SoAArray&& other) noexcept
+	{
+		if (this != &other)
+		{
+			cleanup();
+			mBlock = std::exchange(other.mBlock, nullptr);
+			mColumns = std::exchange(other.mColumns, {});
+			mCount = std::exchange(other.mCount, 0);
+			mCapacity = std::exchange(other.mCapacity, 0);
+		}
+		return *this;
+	}
+
+	Reference operator[](size_t index)
+	{
+		checkRange(index);
+		return std::apply([index](Fields*... columns) { return Reference(columns[index]...); }, mColumns);
+	}
+
+	ConstReference operator[](size_t index) const
+	{
+		checkRange(index);
+		return std::apply([index](Fields*... columns) { return ConstReference(columns[index]...); }, mColumns);
+	}
+
+public:
+	void Add(const Fields&... values)
+	{
+		Emplace(values...);
+	}
+
+	void Add(Fields&&... values)
+	{
+		Emplace(std::move(values)...);
+	}
+
+	size_t Capacity() const noexcept
+	{
+		return mCapacity;
+	}
+
+	void Clear() noexcept
+	{
+		forEachColumn([this](auto* column) { std::destroy_n(column, mCount); });
+		mCount = 0;
+	}
+
+	template <size_t I>
+	std::span<FieldType<I>> Column() noexcept
+	{
+		return std::span<FieldType<I>>(std::get<I>(mColumns), mCount);
+	}
+
+	template <size_t I>
+	std::span<const FieldType<I>> Column() const noexcept
+	{
+		return std::span<const FieldType<I>>(std::get<I>(mColumns), mCount);
+	}
+
+	size_t Count() const noexcept
+	{
+		return mCount;
+	}
+
+	template <typename... Args>
+	Reference Emplace(Args&&... args)
+	{
+		static_assert(sizeof...(Args) == sizeof...(Fields), "Emplace requires one argument per field");
+
+		ensureCapacity(mCount + 1);
+		emplaceBack(std::index_sequence_for<Fields...>{}, std::forward<Args>(args)...);
+		++mCount;
+
+		return (*this)[mCount - 1];
+	}
+
+	template <typename Predicate>
+	size_t FindIf(Predicate pred) const
+	{
+		for (size_t i = 0; i < mCount; ++i)
+		{
+			if (pred((*this)[i]))
+			{
+				return i;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	template <size_t I>
+	FieldType<I>& Get(size_t index)
+	{
+		checkRange(index);
+		return std::get<I>(mColumns)[index];
+	}
+
+	template <size_t I>
+	const FieldType<I>& Get(size_t index) const
+	{
+		checkRange(index);
+		return std::get<I>(mColumns)[index];
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return mCount == 0;
+	}
+
+	void RemoveAt(size_t index)
+	{
+		checkRange(index);
+		forEachColumn([this, index](auto* column)
+			{
+				std::move(column + index + 1, column + mCount, column + index);
+				std::destroy_at(column + mCount - 1);
+			});
+		--mCount;
+	}
+
+	void Reserve(size_t newCapacity)
+	{
+		if (newCapacity > mCapacity)
+		{
+			reallocate(newCapacity);
+		}
+	}
+
+	void Shrink()
+	{
+		if (mCapacity > mCount)
+		{
+			reallocate(mCount);
+		}
+	}
+
+	// Compares whole rows as ConstReference tuples, then gathers every column through the
+	// resulting permutation into a fresh block so each column is moved exactly once.
+	template <typename Compare>
+	void Sort(Compare comp)
+	{
+		if (mCount < 2)
+		{
+			return;
+		}
+
+		Array<size_t> order(mCount);
+		for (size_t i = 0; i < mCount; ++i)
+		{
+			order.Add(i);
+		}
+		const SoAArray& rows = *this;
+		order.Sort([&rows, &comp](size_t a, size_t b) { return comp(rows[a], rows[b]); });
+
+		std::byte* newBlock = allocateBlock(mCapacity);
+		Columns newColumns = layoutColumns(newBlock, mCapacity);
+		gatherColumns(newColumns, order.Data(), std::index_sequence_for<Fields...>{});
+
+		size_t count = mCount;
+		size_t capacity = mCapacity;
+		cleanup();
+		mBlock = newBlock;
+		mColumns = newColumns;
+		mCount = count;
+		mCapacity = capacity;
+	}
+
+	void Swap(SoAArray& other) noexcept
+	{
+		std::swap(mBlock, other.mBlock);
+		std::swap(mColumns, other.mColumns);
+		std::swap(mCount, other.mCount);
+		std::swap(mCapacity, other.mCapacity);
+	}
+
+private:
+	using Columns = std::tuple<Fields*...>;
+
+	static constexpr size_t alignUp(size_t offset) noexcept
+	{
+		return (offset + COLUMN_ALIGNMENT - 1) & ~(COLUMN_ALIGNMENT - 1);
+	}
+
+	static size_t blockSize(size_t capacity) noexcept
+	{
+		size_t offset = 0;
+		((offset = alignUp(offset) + sizeof(Fields) * capacity), ...);
+		return offset;
+	}
+
+	static std::byte* allocateBlock(size_t capacity)
+	{
+		return static_cast<std::byte*>(::operator new(blockSize(capacity), std::align_val_t(COLUMN_ALIGNMENT)));
+	}
+
+	static void deallocateBlock(std::byte* block) noexcept
+	{
+		::operator delete(block, std::align_val_t(COLUMN_ALIGNMENT));
+	}
+
+	static Columns layoutColumns(std::byte* block, size_t capacity) noexcept
+	{
+		size_t offset = 0;
+		auto next = [block, capacity, &offset]<typename U>(U*)
+		{
+			offset = alignUp(offset);
+			U* column = reinterpret_cast<U*>(block + offset);
+			offset += sizeof(U) * capacity;
+			return column;
+		};
+		return Columns{ next(static_cast<Fields*>(nullptr))... };
+	}
+
+	template <typename Function>
+	void forEachColumn(Function func)
+	{
+		std::apply([&func](Fields*... columns) { (func(columns), ...); }, mColumns);
+	}
+
+	template <size_t... I, typename... Args>
+	void emplaceBack(std::index_sequence<I...>, Args&&... args)
+	{
+		(std::construct_at(std::get<I>(mColumns) + mCount, std::forward<Args>(args)), ...);
+	}
+
+	template <size_t... I>
+	void copyFrom(const SoAArray& other, std::index_sequence<I...>)
+	{
+		(std::uninitialized_copy_n(std::get<I>(other.mColumns), other.mCount, std::get<I>(mColumns)), ...);
+	}
+
+	template <size_t... I>
+	void moveInto(const Columns& target, size_t count, std::index_sequence<I...>)
+	{
+		(std::uninitialized_move_n(std::get<I>(mColumns), count, std::get<I>(target)), ...);
+	}
+
+	template <size_t... I>
+	void gatherColumns(const Columns& target, const size_t* order, std::index_sequence<I...>)
+	{
+		auto gather = [this, order](auto* source, auto* destination)
+		{
+			for (size_t i = 0; i < mCount; ++i)
+			{
+				std::construct_at(destination + i, std::move(source[order[i]]));
+			}
+		};
+		(gather(std::get<I>(mColumns), std::get<I>(target)), ...);
+	}
+
+	void checkRange(size_t index) const
+	{
+		if (index >= mCount)
+		{
+			throw std::out_of_range("SoAArray index out of range");
+		}
+	}
+
+	void ensureCapacity(size_t minCapacity)
+	{
+		if (minCapacity > mCapacity)
+		{
+			size_t grow = mCapacity + (mCapacity >> 1); // Grow by 1.5x
+			size_t newCapacity = std::max(minCapacity, mCapacity == 0 ? 8 : grow);
+			reallocate(newCapacity);
+		}
+	}
+
+	void reallocate(size_t newCapacity)
+	{
+		if (newCapacity == mCapacity)
+		{
+			return;
+		}
+
+		if (newCapacity == 0)
+		{
+			cleanup();
+			return;
+		}
+
+		std::byte* newBlock = allocateBlock(newCapacity);
+		Columns newColumns = layoutColumns(newBlock, newCapacity);
+		size_t newCount = std::min(mCount, newCapacity);
+
+		if (mBlock)
+		{
+			moveInto(newColumns, newCount, std::index_sequence_for<Fields...>{});
+			cleanup();
+		}
+
+		mBlock = newBlock;
+		mColumns = newColumns;
+		mCount = newCount;
+		mCapacity = newCapacity;
+	}
+
+	void cleanup() noexcept
+	{
+		if (mBlock)
+		{
+			forEachColumn([this](auto* column) { std::destroy_n(column, mCount); });
+			deallocateBlock(mBlock);
+			mBlock = nullptr;
+			mColumns = {};
+			mCount = 0;
+			mCapacity = 0;
+		}
+	}
+
+private:
+	std::byte* mBlock;
+	Columns mColumns;
+	size_t mCount;
+	size_t mCapacity;
+};
+
+} // namespace abouttt
@@ -0,0 +1,324 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+// Presence is tracked in a bitmap, and the index space is split into pages of PAGE_SLOTS
+// slots. Each page packs its present values densely in index order, so a slot's position in
+// its page is the number of set bits before it within the page (its rank). Every bitmap word
+// keeps that rank for its first bit, so a lookup is one stored rank plus one masked popcount,
+// and an insert or removal shifts at most one page of values and WORDS_PER_PAGE ranks.
+//
+// Count() is the number of slots, present or not; PresentCount() is the number of values.
+template <typename T>
+class SparseArray
+{
+public:
+	using Word = uint64_t;
+
+public:
+	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
+	static constexpr size_t WORD_BITS = 64;
+	static constexpr size_t WORDS_PER_PAGE = 8;
+	static constexpr size_t PAGE_SLOTS = WORD_BITS * WORDS_PER_PAGE;
+
+public:
+	SparseArray() noexcept
+		: SparseArray(0)
+	{
+	}
+
+	explicit SparseArray(size_t count)
+		: mWords()
+		, mRanks()
+		, mPages()
+		, mCount(0)
+		, mPresentCount(0)
+	{
+		Resize(count);
+	}
+
+public:
+	T& operator[](size_t index)
+	{
+		return page(index)[valueIndex(index)];
+	}
+
+	const T& operator[](size_t index) const
+	{
+		return page(index)[valueIndex(index)];
+	}
+
+public:
+	void Clear() noexcept
+	{
+		std::fill(mWords.begin(), mWords.end(), Word(0));
+		std::fill(mRanks.begin(), mRanks.end(), uint16_t(0));
+		for (Array<T>& values : mPages)
+		{
+			values.Clear();
+		}
+		mPresentCount = 0;
+	}
+
+	bool Contains(size_t index) const
+	{
+		checkRange(index);
+		return (mWords.Data()[index / WORD_BITS] & bitMask(index)) != 0;
+	}
+
+	size_t Count() const noexcept
+	{
+		return mCount;
+	}
+
+	template <typename... Args>
+	T& Emplace(size_t index, Args&&... args)
+	{
+		Array<T>& values = page(index);
+		size_t position = rank(index);
+		if (Contains(index))
+		{
+			values[position] = T(std::forward<Args>(args)...);
+			return values[position];
+		}
+
+		values.EmplaceAt(position, std::forward<Args>(args)...);
+		mWords.Data()[index / WORD_BITS] |= bitMask(index);
+		adjustRanks(index / WORD_BITS, 1);
+		++mPresentCount;
+		return values[position];
+	}
+
+	template <typename Function>
+	void ForEach(Function func)
+	{
+		forEach(*this, func);
+	}
+
+	template <typename Function>
+	void ForEach(Function func) const
+	{
+		forEach(*this, func);
+	}
+
+	T* Get(size_t index)
+	{
+		return Contains(index) ? page(index).Data() + rank(index) : nullptr;
+	}
+
+	const T* Get(size_t index) const
+	{
+		return Contains(index) ? page(index).Data() + rank(index) : nullptr;
+	}
+
+	// True when there are no slots, matching Count(); see PresentCount() for populated slots.
+	bool IsEmpty() const noexcept
+	{
+		return mCount == 0;
+	}
+
+	size_t PageCount() const noexcept
+	{
+		return mPages.Count();
+	}
+
+	// The present values of one page, in index order.
+	std::span<T> PageValues(size_t pageIndex)
+	{
+		checkPageRange(pageIndex);
+		return std::span<T>(mPages[pageIndex].Data(), mPages[pageIndex].Count());
+	}
+
+	std::span<const T> PageValues(size_t pageIndex) const
+	{
+		checkPageRange(pageIndex);
+		return std::span<const T>(mPages[pageIndex].Data(), mPages[pageIndex].Count());
+	}
+
+	size_t PresentCount() const noexcept
+	{
+		return mPresentCount;
+	}
+
+	bool Remove(size_t index)
+	{
+		if (!Contains(index))
+		{
+			return false;
+		}
+
+		page(index).RemoveAt(rank(index));
+		mWords.Data()[index / WORD_BITS] &= ~bitMask(index);
+		adjustRanks(index / WORD_BITS, uint16_t(-1));
+		--mPresentCount;
+		return true;
+	}
+
+	void Resize(size_t newCount)
+	{
+		size_t oldWords = mWords.Count();
+		size_t newWords = (newCount + WORD_BITS - 1) / WORD_BITS;
+		size_t newPages = (newCount + PAGE_SLOTS - 1) / PAGE_SLOTS;
+
+		if (newCount < mCount)
+		{
+			for (size_t p = newPages; p < mPages.Count(); ++p)
+			{
+				mPresentCount -= mPages[p].Count();
+			}
+			if (newCount % PAGE_SLOTS != 0)
+			{
+				Array<T>& values = mPages[newPages - 1];
+				size_t keep = rank(newCount - 1) + (Contains(newCount - 1) ? 1 : 0);
+				mPresentCount -= values.Count() - keep;
+				values.Resize(keep);
+			}
+			if (newCount % WORD_BITS != 0)
+			{
+				mWords.Data()[newWords - 1] &= bitMask(newCount) - 1;
+			}
+		}
+
+		mWords.Resize(newWords, 0);
+		mRanks.Resize(newWords, 0);
+		mPages.Resize(newPages);
+		mCount = newCount;
+
+		// Words added to a partly used page start after that page's present values.
+		for (size_t w = oldWords; w < newWords && w % WORDS_PER_PAGE != 0; ++w)
+		{
+			mRanks.Data()[w] = static_cast<uint16_t>(mRanks.Data()[w - 1] + std::popcount(mWords.Data()[w - 1]));
+		}
+	}
+
+	void Set(size_t index, const T& value)
+	{
+		Emplace(index, value);
+	}
+
+	void Set(size_t index, T&& value)
+	{
+		Emplace(index, std::move(value));
+	}
+
+	void Shrink()
+	{
+		for (Array<T>& values : mPages)
+		{
+			values.Shrink();
+		}
+	}
+
+	void Swap(SparseArray& other) noexcept
+	{
+		mWords.Swap(other.mWords);
+		mRanks.Swap(other.mRanks);
+		mPages.Swap(other.mPages);
+		std::swap(mCount, other.mCount);
+		std::swap(mPresentCount, other.mPresentCount);
+	}
+
+private:
+	static constexpr Word bitMask(size_t index) noexcept
+	{
+		return Word(1) << (index % WORD_BITS);
+	}
+
+	template <typename Self, typename Function>
+	static void forEach(Self& self, Function& func)
+	{
+		const Word* words = self.mWords.Data();
+		for (size_t p = 0, pageCount = self.mPages.Count(); p < pageCount; ++p)
+		{
+			auto* values = self.mPages[p].Data();
+			size_t last = std::min(self.mWords.Count(), (p + 1) * WORDS_PER_PAGE);
+			for (size_t i = p * WORDS_PER_PAGE; i < last; ++i)
+			{
+				for (Word word = words[i]; word != 0; word &= word - 1)
+				{
+					func(i * WORD_BITS + static_cast<size_t>(std::countr_zero(word)), *values++);
+				}
+			}
+		}
+	}
+
+	Array<T>& page(size_t index)
+	{
+		checkRange(index);
+		return mPages[index / PAGE_SLOTS];
+	}
+
+	const Array<T>& page(size_t index) const
+	{
+		checkRange(index);
+		return mPages[index / PAGE_SLOTS];
+	}
+
+	// Position of index within its page's values: the stored rank of its word plus the set
+	// bits below it in that word.
+	size_t rank(size_t index) const
+	{
+		checkRange(index);
+
+		size_t wordIndex = index / WORD_BITS;
+		Word below = mWords.Data()[wordIndex] & (bitMask(index) - 1);
+		return mRanks.Data()[wordIndex] + static_cast<size_t>(std::popcount(below));
+	}
+
+	size_t valueIndex(size_t index) const
+	{
+		if (!Contains(index))
+		{
+			throw std::out_of_range("SparseArray slot is empty");
+		}
+		return rank(index);
+	}
+
+	// Shifts the ranks of the words after wordIndex in the same page; delta wraps to subtract.
+	void adjustRanks(size_t wordIndex, uint16_t delta) noexcept
+	{
+		uint16_t* ranks = mRanks.Data();
+		size_t pageEnd = std::min(mRanks.Count(), (wordIndex / WORDS_PER_PAGE + 1) * WORDS_PER_PAGE);
+		for (size_t i = wordIndex + 1; i < pageEnd; ++i)
+		{
+			ranks[i] = static_cast<uint16_t>(ranks[i] + delta);
+		}
+	}
+
+	void checkRange(size_t index) const
+	{
+		if (index >= mCount)
+		{
+			throw std::out_of_range("SparseArray index out of range");
+		}
+	}
+
+	void checkPageRange(size_t pageIndex) const
+	{
+		if (pageIndex >= mPages.Count())
+		{
+			throw std::out_of_range("SparseArray page index out of range");
+		}
+	}
+
+private:
+	Array<Word> mWords;
+	Array<uint16_t> mRanks;
+	Array<Array<T>> mPages;
+	size_t mCount;
+	size_t mPresentCount;
+};
+
+} // namespace abouttt
@@ -0,0 +1,395 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+// Elements live in inline storage, so the container never allocates. Growing past N throws
+// std::length_error instead of spilling to the heap; TryAdd reports overflow without throwing.
+template <typename T, size_t N>
+class StaticArray
+{
+	static_assert(N > 0, "StaticArray requires a non-zero capacity");
+
+public:
+	using Iterator = ArrayIterator<T>;
+	using ConstIterator = ArrayIterator<const T>;
+	using ReverseIterator = std::reverse_iterator<Iterator>;
+	using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+public:
+	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
+
+public:
+	StaticArray() noexcept
+		: mCount(0)
+	{
+	}
+
+	StaticArray(std::initializer_list<T> ilist)
+		: StaticArray()
+	{
+		Insert(0, ilist.begin(), ilist.size());
+	}
+
+	StaticArray(const StaticArray& other) requires std::is_trivially_copyable_v<T> = default;
+
+	StaticArray(const StaticArray& other)
+		: StaticArray()
+	{
+		std::uninitialized_copy_n(other.Data(), other.mCount, Data());
+		mCount = other.mCount;
+	}
+
+	StaticArray(StaticArray&& other) noexcept requires std::is_trivially_copyable_v<T> = default;
+
+	StaticArray(StaticArray&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+		: StaticArray()
+	{
+		std::uninitialized_move_n(other.Data(), other.mCount, Data());
+		mCount = other.mCount;
+		other.Clear();
+	}
+
+	~StaticArray() requires std::is_trivially_destructible_v<T> = default;
+
+	~StaticArray()
+	{
+		Clear();
+	}
+
+public:
+	StaticArray& operator=(const StaticArray& other) requires std::is_trivially_copyable_v<T> = default;
+
+	StaticArray& operator=(const StaticArray& other)
+	{
+		if (this != &other)
+		{
+			Clear();
+			std::uninitialized_copy_n(other.Data(), other.mCount, Data());
+			mCount = other.mCount;
+		}
+		return *this;
+	}
+
+	StaticArray& operator=(StaticArray&& other) noexcept requires std::is_trivially_copyable_v<T> = default;
+
+	StaticArray& operator=(StaticArray&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		if (this != &other)
+		{
+			Clear();
+			std::uninitialized_move_n(other.Data(), other.mCount, Data());
+			mCount = other.mCount;
+			other.Clear();
+		}
+		return *this;
+	}
+
+	T& operator[](size_t index)
+	{
+		checkRange(index);
+		return Data()[index];
+	}
+
+	const T& operator[](size_t index) const
+	{
+		checkRange(index);
+		return Data()[index];
+	}
+
+	auto operator<=>(const StaticArray& other) const
+	{
+		return std::lexicographical_compare_three_way(
+			Data(), Data() + mCount,
+			other.Data(), other.Data() + other.mCount
+		);
+	}
+
+	bool operator==(const StaticArray& other) const
+	{
+		return mCount == other.mCount && std::equal(Data(), Data() + mCount, other.Data());
+	}
+
+public:
+	void Add(const T& value)
+	{
+		Emplace(value);
+	}
+
+	void Add(T&& value)
+	{
+		Emplace(std::move(value));
+	}
+
+	void Append(const T* ptr, size_t count)
+	{
+		Insert(mCount, ptr, count);
+	}
+
+	static constexpr size_t Capacity() noexcept
+	{
+		return N;
+	}
+
+	void Clear() noexcept
+	{
+		std::destroy_n(Data(), mCount);
+		mCount = 0;
+	}
+
+	bool Contains(const T& value) const
+	{
+		return Find(value) != INDEX_NONE;
+	}
+
+	template <typename Predicate>
+	bool ContainsIf(Predicate pred) const
+	{
+		return FindIf(pred) != INDEX_NONE;
+	}
+
+	size_t Count() const noexcept
+	{
+		return mCount;
+	}
+
+	T* Data() noexcept
+	{
+		return std::launder(reinterpret_cast<T*>(mStorage));
+	}
+
+	const T* Data() const noexcept
+	{
+		return std::launder(reinterpret_cast<const T*>(mStorage));
+	}
+
+	template <typename... Args>
+	T& Emplace(Args&&... args)
+	{
+		size_t index = EmplaceAt(mCount, std::forward<Args>(args)...);
+		return Data()[index];
+	}
+
+	template <typename... Args>
+	size_t EmplaceAt(size_t index, Args&&... args)
+	{
+		checkRange(index, true);
+		checkCapacity(1);
+
+		T* data = Data();
+		if (index < mCount)
+		{
+			std::uninitialized_move_n(data + mCount - 1, 1, data + mCount);
+			std::move_backward(data + index, data + mCount - 1, data + mCount);
+			std::destroy_at(data + index);
+		}
+		std::construct_at(data + index, std::forward<Args>(args)...);
+		++mCount;
+
+		return index;
+	}
+
+	size_t Find(const T& value) const
+	{
+		const T* it = std::find(Data(), Data() + mCount, value);
+		return it != Data() + mCount ? static_cast<size_t>(it - Data()) : INDEX_NONE;
+	}
+
+	template <typename Predicate>
+	size_t FindIf(Predicate pred) const
+	{
+		const T* it = std::find_if(Data(), Data() + mCount, pred);
+		return it != Data() + mCount ? static_cast<size_t>(it - Data()) : INDEX_NONE;
+	}
+
+	size_t Insert(size_t index, const T& value)
+	{
+		return EmplaceAt(index, value);
+	}
+
+	size_t Insert(size_t index, T&& value)
+	{
+		return EmplaceAt(index, std::move(value));
+	}
+
+	size_t Insert(size_t index, const T* ptr, size_t count)
+	{
+		checkRange(index, true);
+		checkCapacity(count);
+
+		T* data = Data();
+		size_t tail = mCount - index;
+		size_t moved = std::min(tail, count);
+		std::uninitialized_move_n(data + mCount - moved, moved, data + mCount + count - moved);
+		std::move_backward(data + index, data + mCount - moved, data + mCount + count - moved);
+		std::destroy_n(data + index, moved);
+		std::uninitialized_copy_n(ptr, count, data + index);
+		mCount += count;
+
+		return index;
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return mCount == 0;
+	}
+
+	bool IsFull() const noexcept
+	{
+		return mCount == N;
+	}
+
+	bool Remove(const T& value)
+	{
+		size_t index = Find(value);
+		if (index != INDEX_NONE)
+		{
+			RemoveAt(index);
+			return true;
+		}
+		return false;
+	}
+
+	template <typename Predicate>
+	size_t RemoveAll(Predicate pred)
+	{
+		T* data = Data();
+		T* newEnd = std::remove_if(data, data + mCount, pred);
+		size_t removedCount = static_cast<size_t>((data + mCount) - newEnd);
+		std::destroy(newEnd, data + mCount);
+		mCount -= removedCount;
+		return removedCount;
+	}
+
+	void RemoveAt(size_t index)
+	{
+		checkRange(index);
+		T* data = Data();
+		std::move(data + index + 1, data + mCount, data + index);
+		std::destroy_at(data + mCount - 1);
+		--mCount;
+	}
+
+	void Resize(size_t newCount, const T& value = T())
+	{
+		if (newCount > N)
+		{
+			throw std::length_error("StaticArray capacity exceeded");
+		}
+		if (newCount > mCount)
+		{
+			std::uninitialized_fill_n(Data() + mCount, newCount - mCount, value);
+		}
+		else
+		{
+			std::destroy_n(Data() + newCount, mCount - newCount);
+		}
+		mCount = newCount;
+	}
+
+	template <typename Compare>
+	void Sort(Compare comp)
+	{
+		std::sort(Data(), Data() + mCount, comp);
+	}
+
+	bool TryAdd(const T& value)
+	{
+		if (IsFull())
+		{
+			return false;
+		}
+		std::construct_at(Data() + mCount, value);
+		++mCount;
+		return true;
+	}
+
+	bool TryAdd(T&& value)
+	{
+		if (IsFull())
+		{
+			return false;
+		}
+		std::construct_at(Data() + mCount, std::move(value));
+		++mCount;
+		return true;
+	}
+
+public: // Iterators for range-based loop support.
+	Iterator begin() noexcept
+	{
+		return Iterator(Data());
+	}
+
+	ConstIterator begin() const noexcept
+	{
+		return ConstIterator(Data());
+	}
+
+	Iterator end() noexcept
+	{
+		return Iterator(Data() + mCount);
+	}
+
+	ConstIterator end() const noexcept
+	{
+		return ConstIterator(Data() + mCount);
+	}
+
+	ReverseIterator rbegin() noexcept
+	{
+		return ReverseIterator(end());
+	}
+
+	ConstReverseIterator rbegin() const noexcept
+	{
+		return ConstReverseIterator(end());
+	}
+
+	ReverseIterator rend() noexcept
+	{
+		return ReverseIterator(begin());
+	}
+
+	ConstReverseIterator rend() const noexcept
+	{
+		return ConstReverseIterator(begin());
+	}
+
+private:
+	void checkRange(size_t index, bool bAllowEnd = false) const
+	{
+		if (index >= mCount + (bAllowEnd ? 1 : 0))
+		{
+			throw std::out_of_range("StaticArray index out of range");
+		}
+	}
+
+	void checkCapacity(size_t additional) const
+	{
+		if (additional > N - mCount)
+		{
+			throw std::length_error("StaticArray capacity exceeded");
+		}
+	}
+
+private:
+	alignas(T) std::byte mStorage[sizeof(T) * N];
+	size_t mCount;
+};
+
+} // namespace abouttt
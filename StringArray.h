@@ -0,0 +1,325 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+// Variable-length strings stored back to back in one byte Array, with string i occupying
+// [offsets[i], offsets[i + 1]). Adding a string never allocates per value, and scans walk
+// contiguous memory. As in JaggedArray, the leading zero offset is added with the first string.
+class StringArray
+{
+public:
+	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
+
+public:
+	StringArray() noexcept
+		: mBytes()
+		, mOffsets()
+	{
+	}
+
+	StringArray(std::initializer_list<std::string_view> ilist)
+		: StringArray()
+	{
+		Reserve(ilist.size(), 0);
+		for (std::string_view value : ilist)
+		{
+			Add(value);
+		}
+	}
+
+public:
+	std::string_view operator[](size_t index) const
+	{
+		checkRange(index);
+		return view(index);
+	}
+
+	bool operator==(const StringArray& other) const
+	{
+		if (Count() != other.Count() || ByteCount() != other.ByteCount())
+		{
+			return false;
+		}
+		return IsEmpty() || (mOffsets == other.mOffsets && mBytes == other.mBytes);
+	}
+
+public:
+	size_t Add(std::string_view value)
+	{
+		if (mOffsets.IsEmpty())
+		{
+			mOffsets.Add(0);
+		}
+		mBytes.Append(value.data(), value.size());
+		mOffsets.Add(mBytes.Count());
+		return Count() - 1;
+	}
+
+	// Returns the indices that put the strings in ascending byte order. Equal strings keep
+	// their relative order.
+	Array<size_t> ArgSort() const
+	{
+		Array<size_t> order;
+		order.Resize(Count());
+		for (size_t i = 0; i < order.Count(); ++i)
+		{
+			order[i] = i;
+		}
+		std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b)
+		{
+			return view(a) < view(b);
+		});
+		return order;
+	}
+
+	size_t ByteCount() const noexcept
+	{
+		return mBytes.Count();
+	}
+
+	std::span<const char> Bytes() const noexcept
+	{
+		return std::span<const char>(mBytes.Data(), mBytes.Count());
+	}
+
+	void Clear() noexcept
+	{
+		mBytes.Clear();
+		mOffsets.Clear();
+	}
+
+	bool Contains(std::string_view value) const
+	{
+		return Find(value) != INDEX_NONE;
+	}
+
+	size_t Count() const noexcept
+	{
+		return mOffsets.IsEmpty() ? 0 : mOffsets.Count() - 1;
+	}
+
+	size_t CountWithPrefix(std::string_view prefix) const
+	{
+		size_t result = 0;
+		forEachWithPrefix(prefix, [&result](size_t) { ++result; });
+		return result;
+	}
+
+	// Removes repeated strings, keeping the first occurrence of each in its original order.
+	// Returns, for every old index, the index of its string after deduplication.
+	Array<size_t> Dedupe()
+	{
+		Array<size_t> remap;
+		remap.Resize(Count());
+
+		StringArray unique;
+		std::unordered_map<std::string_view, size_t> seen;
+		seen.reserve(Count());
+
+		for (size_t i = 0, n = Count(); i < n; ++i)
+		{
+			auto [it, bInserted] = seen.try_emplace(view(i), unique.Count());
+			if (bInserted)
+			{
+				unique.Add(view(i));
+			}
+			remap[i] = it->second;
+		}
+
+		unique.Shrink();
+		Swap(unique);
+		return remap;
+	}
+
+	size_t Find(std::string_view value) const
+	{
+		for (size_t i = 0, n = Count(); i < n; ++i)
+		{
+			if (view(i) == value)
+			{
+				return i;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	Array<size_t> FindWithPrefix(std::string_view prefix) const
+	{
+		Array<size_t> result;
+		forEachWithPrefix(prefix, [&result](size_t index) { result.Add(index); });
+		return result;
+	}
+
+	template <typename Function>
+	void ForEach(Function func) const
+	{
+		for (size_t i = 0, n = Count(); i < n; ++i)
+		{
+			func(i, view(i));
+		}
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return Count() == 0;
+	}
+
+	size_t Length(size_t index) const
+	{
+		checkRange(index);
+		return mOffsets.Data()[index + 1] - mOffsets.Data()[index];
+	}
+
+	std::span<const size_t> Offsets() const noexcept
+	{
+		return std::span<const size_t>(mOffsets.Data(), mOffsets.Count());
+	}
+
+	void RemoveLast()
+	{
+		if (IsEmpty())
+		{
+			throw std::out_of_range("StringArray index out of range");
+		}
+		mOffsets.RemoveAt(Count());
+		mBytes.Resize(mOffsets.Data()[Count()]);
+	}
+
+	void Reserve(size_t count, size_t byteCount)
+	{
+		mOffsets.Reserve(count + 1);
+		mBytes.Reserve(byteCount);
+	}
+
+	void Shrink()
+	{
+		mBytes.Shrink();
+		mOffsets.Shrink();
+	}
+
+	// Reorders the strings by ArgSort, rebuilding both Arrays in one gather pass.
+	void Sort()
+	{
+		Array<size_t> order = ArgSort();
+
+		StringArray sorted;
+		sorted.Reserve(Count(), ByteCount());
+		for (size_t index : order)
+		{
+			sorted.Add(view(index));
+		}
+		Swap(sorted);
+	}
+
+	bool StartsWith(size_t index, std::string_view prefix) const
+	{
+		checkRange(index);
+		return view(index).starts_with(prefix);
+	}
+
+	void Swap(StringArray& other) noexcept
+	{
+		mBytes.Swap(other.mBytes);
+		mOffsets.Swap(other.mOffsets);
+	}
+
+private:
+	using Word = uint64_t;
+
+	static constexpr size_t WORD_BYTES = sizeof(Word);
+
+	static Word loadWord(const char* ptr, size_t count) noexcept
+	{
+		Word word = 0;
+		if (count > 0)
+		{
+			std::memcpy(&word, ptr, count);
+		}
+		return word;
+	}
+
+	// Selects the bytes a partial load filled, which sit at the low end on little-endian targets.
+	static constexpr Word leadingBytesMask(size_t count) noexcept
+	{
+		if (count == 0)
+		{
+			return 0;
+		}
+		Word mask = ~Word(0);
+		if (count < WORD_BYTES)
+		{
+			mask = std::endian::native == std::endian::little ? mask >> ((WORD_BYTES - count) * 8) : mask << ((WORD_BYTES - count) * 8);
+		}
+		return mask;
+	}
+
+	// Compares the first eight bytes of every candidate against the prefix as one masked
+	// 64-bit word, only falling back to memcmp for the remainder of longer prefixes.
+	template <typename Function>
+	void forEachWithPrefix(std::string_view prefix, Function func) const
+	{
+		size_t headBytes = std::min(prefix.size(), WORD_BYTES);
+		Word head = loadWord(prefix.data(), headBytes);
+		Word mask = leadingBytesMask(headBytes);
+
+		const char* bytes = mBytes.Data();
+		const size_t* offsets = mOffsets.Data();
+		size_t byteCount = mBytes.Count();
+
+		for (size_t i = 0, n = Count(); i < n; ++i)
+		{
+			size_t start = offsets[i];
+			if (offsets[i + 1] - start < prefix.size())
+			{
+				continue;
+			}
+
+			Word word = loadWord(bytes + start, std::min(WORD_BYTES, byteCount - start));
+			if (((word ^ head) & mask) != 0)
+			{
+				continue;
+			}
+			if (prefix.size() <= WORD_BYTES
+				|| std::memcmp(bytes + start + WORD_BYTES, prefix.data() + WORD_BYTES, prefix.size() - WORD_BYTES) == 0)
+			{
+				func(i);
+			}
+		}
+	}
+
+	std::string_view view(size_t index) const noexcept
+	{
+		const size_t* offsets = mOffsets.Data();
+		return std::string_view(mBytes.Data() + offsets[index], offsets[index + 1] - offsets[index]);
+	}
+
+	void checkRange(size_t index) const
+	{
+		if (index >= Count())
+		{
+			throw std::out_of_range("StringArray index out of range");
+		}
+	}
+
+private:
+	Array<char> mBytes;
+	Array<size_t> mOffsets;
+};
+
+} // namespace abouttt
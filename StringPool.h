@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "Array.h"
+#include "StringArray.h"
+
+namespace abouttt
+{
+
+// Interns strings as dense 32-bit IDs. Bytes are copied once into large append-only chunks,
+// which are never reallocated, so every returned string_view stays valid for the pool's
+// lifetime. Lookups probe an open-addressing table of (hash, id) slots.
+//
+// After Freeze() the pool is read-only: Find and Get touch only immutable data and may be
+// called from any number of threads without locking. Before that, the pool is not thread-safe.
+class StringPool
+{
+public:
+	using Id = uint32_t;
+
+public:
+	static constexpr Id ID_NONE = std::numeric_limits<Id>::max();
+	static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+public:
+	StringPool() noexcept
+		: mChunks()
+		, mStrings()
+		, mSlots()
+		, mByteCount(0)
+		, mbFrozen(false)
+	{
+	}
+
+	// Views handed out point into this pool's chunks, so a copy could not share them safely.
+	StringPool(const StringPool&) = delete;
+	StringPool(StringPool&&) noexcept = default;
+
+public:
+	StringPool& operator=(const StringPool&) = delete;
+	StringPool& operator=(StringPool&&) noexcept = default;
+
+	std::string_view operator[](Id id) const
+	{
+		return Get(id);
+	}
+
+public:
+	size_t ByteCount() const noexcept
+	{
+		return mByteCount;
+	}
+
+	void Clear()
+	{
+		checkMutable();
+		mChunks.Clear();
+		mStrings.Clear();
+		mSlots.Clear();
+		mByteCount = 0;
+	}
+
+	size_t Count() const noexcept
+	{
+		return mStrings.Count();
+	}
+
+	Id Find(std::string_view value) const
+	{
+		if (mSlots.IsEmpty())
+		{
+			return ID_NONE;
+		}
+		return mSlots.Data()[findSlot(value, hashOf(value))].StringId;
+	}
+
+	// Makes the pool read-only and trims spare capacity from the id-to-string index.
+	void Freeze()
+	{
+		mStrings.Shrink();
+		mbFrozen = true;
+	}
+
+	std::string_view Get(Id id) const
+	{
+		if (id >= mStrings.Count())
+		{
+			throw std::out_of_range("StringPool id out of range");
+		}
+		return mStrings.Data()[id];
+	}
+
+	Id Intern(std::string_view value)
+	{
+		checkMutable();
+		ensureSlots(mStrings.Count() + 1);
+
+		uint32_t hash = hashOf(value);
+		Slot& slot = mSlots.Data()[findSlot(value, hash)];
+		if (slot.StringId == ID_NONE)
+		{
+			slot.Hash = hash;
+			slot.StringId = addString(value);
+		}
+		return slot.StringId;
+	}
+
+	// Interns every string in order and returns the ID for each input index. The table and
+	// byte chunks grow with the distinct strings only, as in Intern, so duplicates add no space.
+	Array<Id> InternAll(const StringArray& values)
+	{
+		checkMutable();
+
+		Array<Id> ids;
+		ids.Resize(values.Count());
+		values.ForEach([this, &ids](size_t index, std::string_view value)
+		{
+			ids[index] = Intern(value);
+		});
+		return ids;
+	}
+
+	bool IsFrozen() const noexcept
+	{
+		return mbFrozen;
+	}
+
+private:
+	struct Slot
+	{
+		uint32_t Hash;
+		Id StringId;
+	};
+
+	static uint32_t hashOf(std::string_view value) noexcept
+	{
+		uint64_t hash = std::hash<std::string_view>()(value);
+		return static_cast<uint32_t>(hash ^ (hash >> 32));
+	}
+
+	// Linear probing: returns the slot holding value, or the empty slot where it belongs.
+	size_t findSlot(std::string_view value, uint32_t hash) const noexcept
+	{
+		const Slot* slots = mSlots.Data();
+		size_t mask = mSlots.Count() - 1;
+		for (size_t i = hash & mask; ; i = (i + 1) & mask)
+		{
+			const Slot& slot = slots[i];
+			if (slot.StringId == ID_NONE
+				|| (slot.Hash == hash && mStrings.Data()[slot.StringId] == value))
+			{
+				return i;
+			}
+		}
+	}
+
+	// Keeps the table at most three quarters full, rehashing from the stored hashes.
+	void ensureSlots(size_t minCount)
+	{
+		if (minCount >= ID_NONE)
+		{
+			throw std::length_error("StringPool id space exhausted");
+		}
+		if (minCount * 4 <= mSlots.Count() * 3)
+		{
+			return;
+		}
+
+		size_t newCapacity = std::bit_ceil(std::max<size_t>(16, (minCount * 4 + 2) / 3));
+		Array<Slot> slots;
+		slots.Resize(newCapacity, Slot{ 0, ID_NONE });
+
+		size_t mask = newCapacity - 1;
+		for (const Slot& slot : mSlots)
+		{
+			if (slot.StringId != ID_NONE)
+			{
+				size_t i = slot.Hash & mask;
+				while (slots.Data()[i].StringId != ID_NONE)
+				{
+					i = (i + 1) & mask;
+				}
+				slots.Data()[i] = slot;
+			}
+		}
+		mSlots.Swap(slots);
+	}
+
+	// Starts a new chunk when the current one cannot take byteCount more bytes. Chunks are
+	// only appended within their reserved capacity, so their storage never moves.
+	void reserveBytes(size_t byteCount)
+	{
+		if (mChunks.IsEmpty())
+		{
+			mChunks.Emplace(std::max(CHUNK_SIZE, byteCount));
+			return;
+		}
+
+		const Array<char>& chunk = mChunks[mChunks.Count() - 1];
+		if (chunk.Capacity() - chunk.Count() < byteCount)
+		{
+			mChunks.Emplace(std::max(CHUNK_SIZE, byteCount));
+		}
+	}
+
+	Id addString(std::string_view value)
+	{
+		reserveBytes(value.size());
+
+		Array<char>& chunk = mChunks[mChunks.Count() - 1];
+		size_t offset = chunk.Count();
+		chunk.Append(value.data(), value.size());
+		mByteCount += value.size();
+
+		mStrings.Add(std::string_view(chunk.Data() + offset, value.size()));
+		return static_cast<Id>(mStrings.Count() - 1);
+	}
+
+	void checkMutable() const
+	{
+		if (mbFrozen)
+		{
+			throw std::logic_error("StringPool is frozen");
+		}
+	}
+
+private:
+	Array<Array<char>> mChunks;
+	Array<std::string_view> mStrings;
+	Array<Slot> mSlots;
+	size_t mByteCount;
+	bool mbFrozen;
+};
+
+} // namespace abouttt
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "BasicCompactArray.h"
+
+namespace abouttt
+{
+
+// Storage for ThinArray: a single pointer to a heap block that starts with the count and
+// capacity, followed by the elements.
+template <typename T>
+class ThinArrayStorage
+{
+public:
+	static constexpr const char* NAME = "ThinArray";
+
+public:
+	ThinArrayStorage() noexcept
+		: mHeader(nullptr)
+	{
+	}
+
+	ThinArrayStorage(ThinArrayStorage&& other) noexcept
+		: mHeader(std::exchange(other.mHeader, nullptr))
+	{
+	}
+
+	ThinArrayStorage(const ThinArrayStorage&) = delete;
+	ThinArrayStorage& operator=(const ThinArrayStorage&) = delete;
+
+public:
+	size_t Capacity() const noexcept
+	{
+		return mHeader ? mHeader->Capacity : 0;
+	}
+
+	size_t Count() const noexcept
+	{
+		return mHeader ? mHeader->Count : 0;
+	}
+
+	T* Data() const noexcept
+	{
+		return mHeader ? elements(mHeader) : nullptr;
+	}
+
+	void Reallocate(size_t newCapacity)
+	{
+		if (newCapacity == 0)
+		{
+			Release();
+			return;
+		}
+
+		void* block = ::operator new(DATA_OFFSET + sizeof(T) * newCapacity, std::align_val_t(BLOCK_ALIGNMENT));
+		Header* newHeader = ::new (block) Header{ 0, static_cast<uint32_t>(newCapacity) };
+
+		if (mHeader)
+		{
+			newHeader->Count = mHeader->Count;
+			std::uninitialized_move_n(elements(mHeader), mHeader->Count, elements(newHeader));
+			Release();
+		}
+
+		mHeader = newHeader;
+	}
+
+	void Release() noexcept
+	{
+		if (mHeader)
+		{
+			std::destroy_n(elements(mHeader), mHeader->Count);
+			::operator delete(mHeader, std::align_val_t(BLOCK_ALIGNMENT));
+			mHeader = nullptr;
+		}
+	}
+
+	void SetCount(size_t count) noexcept
+	{
+		mHeader->Count = static_cast<uint32_t>(count);
+	}
+
+	void Swap(ThinArrayStorage& other) noexcept
+	{
+		std::swap(mHeader, other.mHeader);
+	}
+
+private:
+	struct Header
+	{
+		uint32_t Count;
+		uint32_t Capacity;
+	};
+
+	static constexpr size_t BLOCK_ALIGNMENT = std::max(alignof(Header), alignof(T));
+	static constexpr size_t DATA_OFFSET = (sizeof(Header) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+	static T* elements(Header* header) noexcept
+	{
+		return reinterpret_cast<T*>(reinterpret_cast<std::byte*>(header) + DATA_OFFSET);
+	}
+
+private:
+	Header* mHeader;
+};
+
+// Array whose handle is a single pointer: count and capacity live in a header at the front of
+// the heap block, so an empty ThinArray is 8 bytes and owns no allocation.
+template <typename T>
+using ThinArray = BasicCompactArray<T, ThinArrayStorage<T>>;
+
+} // namespace abouttt
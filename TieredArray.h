@@ -0,0 +1,577 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Array.h"
+
+namespace abouttt
+{
+
+template <typename T>
+class TieredArrayIterator;
+
+// Every block except the last is kept full, so index / BlockSize() picks the block in O(1).
+// Insert and RemoveAt shift within one block and then pass a single element through each
+// following block's circular head, which is O(BlockSize() + BlockCount()).
+template <typename T>
+class TieredArray
+{
+public:
+	using Iterator = TieredArrayIterator<T>;
+	using ConstIterator = TieredArrayIterator<const T>;
+	using ReverseIterator = std::reverse_iterator<Iterator>;
+	using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+public:
+	static constexpr size_t INDEX_NONE = std::numeric_limits<size_t>::max();
+	static constexpr size_t MIN_BLOCK_SIZE = 64;
+
+public:
+	TieredArray() noexcept
+		: mBlocks()
+		, mCount(0)
+		, mBlockSize(MIN_BLOCK_SIZE)
+	{
+	}
+
+	TieredArray(std::initializer_list<T> ilist)
+		: TieredArray()
+	{
+		for (const T& value : ilist)
+		{
+			Add(value);
+		}
+	}
+
+	TieredArray(const TieredArray& other)
+		: TieredArray()
+	{
+		mBlockSize = other.mBlockSize;
+		for (const T& value : other)
+		{
+			Add(value);
+		}
+	}
+
+	TieredArray(TieredArray&& other) noexcept
+		: mBlocks(std::move(other.mBlocks))
+		, mCount(std::exchange(other.mCount, 0))
+		, mBlockSize(std::exchange(other.mBlockSize, MIN_BLOCK_SIZE))
+	{
+	}
+
+	~TieredArray()
+	{
+		cleanup();
+	}
+
+public:
+	TieredArray& operator=(const TieredArray& other)
+	{
+		if (this != &other)
+		{
+			TieredArray temp(other);
+			Swap(temp);
+		}
+		return *this;
+	}
+
+	TieredArray& operator=(TieredArray&& other) noexcept
+	{
+		if (this != &other)
+		{
+			cleanup();
+			mBlocks = std::move(other.mBlocks);
+			mCount = std::exchange(other.mCount, 0);
+			mBlockSize = std::exchange(other.mBlockSize, MIN_BLOCK_SIZE);
+		}
+		return *this;
+	}
+
+	T& operator[](size_t index)
+	{
+		checkRange(index);
+		return element(index);
+	}
+
+	const T& operator[](size_t index) const
+	{
+		checkRange(index);
+		return element(index);
+	}
+
+public:
+	void Add(const T& value)
+	{
+		Insert(mCount, value);
+	}
+
+	void Add(T&& value)
+	{
+		Insert(mCount, std::move(value));
+	}
+
+	size_t BlockCount() const noexcept
+	{
+		return mBlocks.Count();
+	}
+
+	size_t BlockSize() const noexcept
+	{
+		return mBlockSize;
+	}
+
+	void Clear() noexcept
+	{
+		cleanup();
+	}
+
+	bool Contains(const T& value) const
+	{
+		return Find(value) != INDEX_NONE;
+	}
+
+	size_t Count() const noexcept
+	{
+		return mCount;
+	}
+
+	size_t Find(const T& value) const
+	{
+		return FindIf([&value](const T& element) { return element == value; });
+	}
+
+	template <typename Predicate>
+	size_t FindIf(Predicate pred) const
+	{
+		for (size_t i = 0; i < mCount; ++i)
+		{
+			if (pred(element(i)))
+			{
+				return i;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	size_t Insert(size_t index, const T& value)
+	{
+		return insertImpl(index, T(value));
+	}
+
+	size_t Insert(size_t index, T&& value)
+	{
+		return insertImpl(index, std::move(value));
+	}
+
+	bool IsEmpty() const noexcept
+	{
+		return mCount == 0;
+	}
+
+	bool Remove(const T& value)
+	{
+		size_t index = Find(value);
+		if (index != INDEX_NONE)
+		{
+			RemoveAt(index);
+			return true;
+		}
+		return false;
+	}
+
+	void RemoveAt(size_t index)
+	{
+		checkRange(index);
+
+		size_t blockIndex = index / mBlockSize;
+		mBlocks[blockIndex].RemoveAt(index % mBlockSize, mBlockSize);
+
+		for (size_t b = blockIndex + 1; b < mBlocks.Count(); ++b)
+		{
+			mBlocks[b - 1].PushBack(mBlocks[b].PopFront(mBlockSize), mBlockSize);
+		}
+
+		Block& last = mBlocks[mBlocks.Count() - 1];
+		if (last.Count == 0)
+		{
+			last.Release();
+			mBlocks.RemoveAt(mBlocks.Count() - 1);
+		}
+		--mCount;
+	}
+
+	void Swap(TieredArray& other) noexcept
+	{
+		mBlocks.Swap(other.mBlocks);
+		std::swap(mCount, other.mCount);
+		std::swap(mBlockSize, other.mBlockSize);
+	}
+
+public: // Iterators for range-based loop support.
+	Iterator begin() noexcept
+	{
+		return Iterator(this, 0);
+	}
+
+	ConstIterator begin() const noexcept
+	{
+		return ConstIterator(this, 0);
+	}
+
+	Iterator end() noexcept
+	{
+		return Iterator(this, mCount);
+	}
+
+	ConstIterator end() const noexcept
+	{
+		return ConstIterator(this, mCount);
+	}
+
+	ReverseIterator rbegin() noexcept
+	{
+		return ReverseIterator(end());
+	}
+
+	ConstReverseIterator rbegin() const noexcept
+	{
+		return ConstReverseIterator(end());
+	}
+
+	ReverseIterator rend() noexcept
+	{
+		return ReverseIterator(begin());
+	}
+
+	ConstReverseIterator rend() const noexcept
+	{
+		return ConstReverseIterator(begin());
+	}
+
+private:
+	friend class TieredArrayIterator<T>;
+	friend class TieredArrayIterator<const T>;
+
+	// A fixed-capacity circular sub-array; the capacity is passed in because it is shared by
+	// every block of the directory.
+	struct Block
+	{
+		T* Data;
+		size_t Head;
+		size_t Count;
+
+		T& At(size_t offset, size_t capacity) const noexcept
+		{
+			return Data[(Head + offset) & (capacity - 1)];
+		}
+
+		void PushBack(T&& value, size_t capacity)
+		{
+			std::construct_at(&At(Count, capacity), std::move(value));
+			++Count;
+		}
+
+		void PushFront(T&& value, size_t capacity)
+		{
+			size_t head = (Head - 1) & (capacity - 1);
+			std::construct_at(Data + head, std::move(value));
+			Head = head;
+			++Count;
+		}
+
+		T PopBack(size_t capacity)
+		{
+			T& last = At(Count - 1, capacity);
+			T result(std::move(last));
+			std::destroy_at(&last);
+			--Count;
+			return result;
+		}
+
+		T PopFront(size_t capacity)
+		{
+			T& first = Data[Head];
+			T result(std::move(first));
+			std::destroy_at(&first);
+			Head = (Head + 1) & (capacity - 1);
+			--Count;
+			return result;
+		}
+
+		void Insert(size_t offset, T&& value, size_t capacity)
+		{
+			if (offset == Count)
+			{
+				PushBack(std::move(value), capacity);
+				return;
+			}
+
+			std::construct_at(&At(Count, capacity), std::move(At(Count - 1, capacity)));
+			for (size_t i = Count - 1; i > offset; --i)
+			{
+				At(i, capacity) = std::move(At(i - 1, capacity));
+			}
+			At(offset, capacity) = std::move(value);
+			++Count;
+		}
+
+		void RemoveAt(size_t offset, size_t capacity)
+		{
+			for (size_t i = offset; i + 1 < Count; ++i)
+			{
+				At(i, capacity) = std::move(At(i + 1, capacity));
+			}
+			std::destroy_at(&At(Count - 1, capacity));
+			--Count;
+		}
+
+		void Release() noexcept
+		{
+			::operator delete(Data);
+			Data = nullptr;
+		}
+	};
+
+	T& element(size_t index) const noexcept
+	{
+		return mBlocks.Data()[index / mBlockSize].At(index % mBlockSize, mBlockSize);
+	}
+
+	Block allocateBlock() const
+	{
+		return Block{ static_cast<T*>(::operator new(sizeof(T) * mBlockSize)), 0, 0 };
+	}
+
+	size_t insertImpl(size_t index, T&& value)
+	{
+		checkRange(index, true);
+
+		// Keep the block size near sqrt(n) so neither term of the cost dominates.
+		if (mBlocks.Count() >= 2 * mBlockSize && mCount % mBlockSize == 0)
+		{
+			rebuild(mBlockSize * 2);
+		}
+
+		if (mCount % mBlockSize == 0)
+		{
+			mBlocks.Add(allocateBlock());
+		}
+
+		T carry = std::move(value);
+		size_t blockIndex = index / mBlockSize;
+		size_t offset = index % mBlockSize;
+
+		for (size_t b = blockIndex; b < mBlocks.Count(); ++b)
+		{
+			Block& block = mBlocks[b];
+			if (block.Count < mBlockSize)
+			{
+				if (b == blockIndex)
+				{
+					block.Insert(offset, std::move(carry), mBlockSize);
+				}
+				else
+				{
+					block.PushFront(std::move(carry), mBlockSize);
+				}
+				break;
+			}
+
+			T overflow = block.PopBack(mBlockSize);
+			if (b == blockIndex)
+			{
+				block.Insert(offset, std::move(carry), mBlockSize);
+			}
+			else
+			{
+				block.PushFront(std::move(carry), mBlockSize);
+			}
+			carry = std::move(overflow);
+		}
+
+		++mCount;
+		return index;
+	}
+
+	void rebuild(size_t newBlockSize)
+	{
+		TieredArray temp;
+		temp.mBlockSize = newBlockSize;
+		temp.mBlocks.Reserve((mCount + newBlockSize - 1) / newBlockSize);
+
+		for (size_t i = 0; i < mCount; ++i)
+		{
+			if (i % newBlockSize == 0)
+			{
+				temp.mBlocks.Add(temp.allocateBlock());
+			}
+			temp.mBlocks[temp.mBlocks.Count() - 1].PushBack(std::move(element(i)), newBlockSize);
+			++temp.mCount;
+		}
+		Swap(temp);
+	}
+
+	void checkRange(size_t index, bool bAllowEnd = false) const
+	{
+		if (index >= mCount + (bAllowEnd ? 1 : 0))
+		{
+			throw std::out_of_range("TieredArray index out of range");
+		}
+	}
+
+	void cleanup() noexcept
+	{
+		for (Block& block : mBlocks)
+		{
+			for (size_t i = 0; i < block.Count; ++i)
+			{
+				std::destroy_at(&block.At(i, mBlockSize));
+			}
+			block.Release();
+		}
+		mBlocks.Clear();
+		mCount = 0;
+	}
+
+private:
+	Array<Block> mBlocks;
+	size_t mCount;
+	size_t mBlockSize;
+};
+
+template <typename T>
+class TieredArrayIterator
+{
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = std::remove_const_t<T>;
+	using difference_type = ptrdiff_t;
+	using pointer = T*;
+	using reference = T&;
+
+	using Owner = std::conditional_t<std::is_const_v<T>, const TieredArray<value_type>, TieredArray<value_type>>;
+
+public:
+	TieredArrayIterator() noexcept
+		: mOwner(nullptr)
+		, mIndex(0)
+	{
+	}
+
+	TieredArrayIterator(Owner* owner, size_t index) noexcept
+		: mOwner(owner)
+		, mIndex(index)
+	{
+	}
+
+	template<typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+	TieredArrayIterator(const TieredArrayIterator<std::remove_const_t<T>>& other) noexcept
+		: mOwner(other.mOwner)
+		, mIndex(other.mIndex)
+	{
+	}
+
+public:
+	T& operator*() const noexcept
+	{
+		return mOwner->element(mIndex);
+	}
+
+	T* operator->() const noexcept
+	{
+		return &mOwner->element(mIndex);
+	}
+
+	T& operator[](size_t index) const noexcept
+	{
+		return mOwner->element(mIndex + index);
+	}
+
+	TieredArrayIterator& operator++() noexcept
+	{
+		++mIndex;
+		return *this;
+	}
+
+	TieredArrayIterator operator++(int) noexcept
+	{
+		TieredArrayIterator temp = *this;
+		++mIndex;
+		return temp;
+	}
+
+	TieredArrayIterator& operator--() noexcept
+	{
+		--mIndex;
+		return *this;
+	}
+
+	TieredArrayIterator operator--(int) noexcept
+	{
+		TieredArrayIterator temp = *this;
+		--mIndex;
+		return temp;
+	}
+
+	TieredArrayIterator& operator+=(ptrdiff_t n) noexcept
+	{
+		mIndex += n;
+		return *this;
+	}
+
+	TieredArrayIterator& operator-=(ptrdiff_t n) noexcept
+	{
+		mIndex -= n;
+		return *this;
+	}
+
+	TieredArrayIterator operator+(size_t n) const noexcept
+	{
+		return TieredArrayIterator(mOwner, mIndex + n);
+	}
+
+	TieredArrayIterator operator-(size_t n) const noexcept
+	{
+		return TieredArrayIterator(mOwner, mIndex - n);
+	}
+
+	ptrdiff_t operator-(const TieredArrayIterator& other) const noexcept
+	{
+		return static_cast<ptrdiff_t>(mIndex) - static_cast<ptrdiff_t>(other.mIndex);
+	}
+
+	bool operator==(const TieredArrayIterator& other) const noexcept
+	{
+		return mIndex == other.mIndex;
+	}
+
+	bool operator!=(const TieredArrayIterator& other) const noexcept
+	{
+		return mIndex != other.mIndex;
+	}
+
+	std::strong_ordering operator<=>(const TieredArrayIterator& other) const noexcept
+	{
+		return mIndex <=> other.mIndex;
+	}
+
+private:
+	friend class TieredArrayIterator<const T>;
+
+	Owner* mOwner;
+	size_t mIndex;
+};
+
+} // namespace abouttt